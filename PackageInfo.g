@@ -387,11 +387,11 @@ Dependencies := rec(
   NeededOtherPackages := [["datastructures", ">=0.2.5"],
                           ["digraphs", ">=1.6.2"],
                           ["genss", ">=1.6.5"],
-                          ["images", ">=1.3.1"],
                           ["IO", ">=4.5.1"],
                           ["orb", ">=4.8.2"]],
   SuggestedOtherPackages := [["GAPDoc", ">=1.6.3"],
-                             ["AutoDoc", ">=2020.08.11"]],
+                             ["AutoDoc", ">=2020.08.11"],
+                             ["images", ">=1.3.1"]],
 
   ExternalConditions := []),
 
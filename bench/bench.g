@@ -0,0 +1,19 @@
+#############################################################################
+##
+##  bench/bench.g
+##  Copyright (C) 2025                                   James D. Mitchell
+##
+##  Licensing information can be found in the README file of this package.
+##
+#############################################################################
+##
+## Runs the benchmarks of the Semigroups package and prints the results as
+## JSON, see bench/README.md.
+
+LoadPackage("semigroups", false);;
+Read(Filename(DirectoriesPackageLibrary("semigroups", "bench"), "harness.g"));
+Read(Filename(DirectoriesPackageLibrary("semigroups", "bench"),
+              "workloads.g"));
+SEMIGROUPS_BENCH.Main();
+QUIT_GAP(0);
+FORCE_QUIT_GAP(1); # if we ever get here, there was an error
@@ -0,0 +1,66 @@
+#!/usr/bin/env python3
+"""
+This simple script compares two JSON files produced by bench/bench.g, for
+example for two different commits, and prints the ratio of the median times
+of every benchmark in both. A benchmark whose recorded value differs between
+the two files is flagged, since its workload no longer computes the same
+thing.
+
+Usage: bench/compare.py BEFORE.json AFTER.json [THRESHOLD]
+
+The exit status is 1 if any benchmark is slower by more than THRESHOLD
+(default 0.1, i.e. 10%) or has a different value, and 0 otherwise.
+"""
+import json
+import sys
+
+
+def load(fname):
+    with open(fname, "r") as f:
+        data = json.load(f)
+    return data, {x["name"]: x for x in data["benchmarks"]}
+
+
+def main():
+    if sys.version_info[0] < 3:
+        raise Exception("Python 3 is required")
+    args = sys.argv[1:]
+    if len(args) not in (2, 3):
+        sys.exit(__doc__)
+    threshold = float(args[2]) if len(args) == 3 else 0.1
+    before_data, before = load(args[0])
+    after_data, after = load(args[1])
+
+    print(
+        "{:<48} {:>12} {:>12} {:>8}".format(
+            "benchmark",
+            str(before_data.get("commit")),
+            str(after_data.get("commit")),
+            "ratio",
+        )
+    )
+    status = 0
+    for name in sorted(set(before) & set(after)):
+        x, y = before[name], after[name]
+        ratio = y["median_ns"] / max(x["median_ns"], 1)
+        flag = ""
+        if x["value"] != y["value"]:
+            flag = " value changed: {} -> {}".format(x["value"], y["value"])
+            status = 1
+        elif ratio > 1 + threshold:
+            flag = " slower"
+            status = 1
+        elif ratio < 1 - threshold:
+            flag = " faster"
+        print(
+            "{:<48} {:>10.3f}ms {:>10.3f}ms {:>8.3f}{}".format(
+                name, x["median_ns"] / 1e6, y["median_ns"] / 1e6, ratio, flag
+            )
+        )
+    for name in sorted(set(before) ^ set(after)):
+        print("{:<48} only in one file".format(name))
+    sys.exit(status)
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,144 @@
+#############################################################################
+##
+##  bench/harness.g
+##  Copyright (C) 2025                                   James D. Mitchell
+##
+##  Licensing information can be found in the README file of this package.
+##
+#############################################################################
+##
+## This file contains the functions for defining, running, and reporting the
+## benchmarks in bench/workloads.g, see bench/README.md.
+
+SEMIGROUPS_BENCH := rec(benchmarks := []);
+
+# Adds a benchmark called <name> of the kind <kind> ("micro" or "macro"). The
+# function <setup> is called with no arguments before every repetition and
+# is not timed, its return value is passed to <run>, which is timed. The
+# value returned by <run> is recorded in the results so that changes to the
+# answers of a workload can be detected.
+
+SEMIGROUPS_BENCH.Add := function(name, kind, setup, run)
+  Add(SEMIGROUPS_BENCH.benchmarks,
+      rec(name := name, kind := kind, setup := setup, run := run));
+end;
+
+# Returns the value of the environment variable <name>, or <default> if it is
+# not set or empty.
+
+SEMIGROUPS_BENCH.Env := function(name, default)
+  local env;
+  env := GAPInfo.SystemEnvironment;
+  if IsBound(env.(name)) and not IsEmpty(env.(name)) then
+    return env.(name);
+  fi;
+  return default;
+end;
+
+SEMIGROUPS_BENCH.Run := function(bench, reps)
+  local times, state, start, value, i;
+
+  times := [];
+  for i in [1 .. reps] do
+    state := bench.setup();
+    start := NanosecondsSinceEpoch();
+    value := bench.run(state);
+    Add(times, NanosecondsSinceEpoch() - start);
+  od;
+  Sort(times);
+
+  return rec(name      := bench.name,
+             kind      := bench.kind,
+             reps      := reps,
+             min_ns    := times[1],
+             median_ns := times[QuoInt(reps + 1, 2)],
+             max_ns    := times[reps],
+             value     := value);
+end;
+
+# Returns a JSON string representing <obj>, which must be an integer, a
+# boolean, fail (as null), a string, a list, or a record. Any other object is
+# represented by the string returned by String.
+
+SEMIGROUPS_BENCH.JSON := function(obj)
+  local Quote;
+
+  Quote := function(str)
+    str := ReplacedString(str, "\\", "\\\\");
+    str := ReplacedString(str, "\"", "\\\"");
+    str := ReplacedString(str, "\n", "\\n");
+    return Concatenation("\"", str, "\"");
+  end;
+
+  if obj = fail then
+    return "null";
+  elif IsBool(obj) then
+    return ViewString(obj);
+  elif IsInt(obj) then
+    return String(obj);
+  elif IsString(obj) and (IsStringRep(obj) or not IsEmpty(obj)) then
+    return Quote(obj);
+  elif IsRecord(obj) then
+    return Concatenation("{",
+                         JoinStringsWithSeparator(
+                           List(SortedList(RecNames(obj)),
+                                x -> Concatenation(Quote(x),
+                                                   ": ",
+                                                   SEMIGROUPS_BENCH.JSON(
+                                                     obj.(x)))),
+                           ", "),
+                         "}");
+  elif IsList(obj) then
+    return Concatenation("[",
+                         JoinStringsWithSeparator(
+                           List(obj, SEMIGROUPS_BENCH.JSON), ", "),
+                         "]");
+  fi;
+  return Quote(String(obj));
+end;
+
+# Runs every benchmark whose name contains the value of the environment
+# variable SEMIGROUPS_BENCH_FILTER (if set), SEMIGROUPS_BENCH_REPS times
+# (default 5), and writes the results as JSON to the file
+# SEMIGROUPS_BENCH_OUTPUT (default standard output). Progress is reported on
+# standard error.
+
+SEMIGROUPS_BENCH.Main := function()
+  local filter, reps, output, results, result, bench, json, stream;
+
+  filter := SEMIGROUPS_BENCH.Env("SEMIGROUPS_BENCH_FILTER", "");
+  reps   := Int(SEMIGROUPS_BENCH.Env("SEMIGROUPS_BENCH_REPS", "5"));
+  output := SEMIGROUPS_BENCH.Env("SEMIGROUPS_BENCH_OUTPUT", fail);
+
+  if reps = fail or reps < 1 then
+    ErrorNoReturn("SEMIGROUPS_BENCH_REPS must be a positive integer");
+  fi;
+
+  results := [];
+  for bench in SEMIGROUPS_BENCH.benchmarks do
+    if IsEmpty(filter) or PositionSublist(bench.name, filter) <> fail then
+      PrintTo("*errout*", "running ", bench.name, " . . . ");
+      result := SEMIGROUPS_BENCH.Run(bench, reps);
+      PrintTo("*errout*", Float(result.median_ns / 10 ^ 6), "ms\n");
+      Add(results, result);
+    fi;
+  od;
+
+  json := SEMIGROUPS_BENCH.JSON(
+    rec(gap        := GAPInfo.Version,
+        semigroups := GAPInfo.PackagesLoaded.semigroups[2],
+        commit     := SEMIGROUPS_BENCH.Env("SEMIGROUPS_BENCH_COMMIT", fail),
+        nr_threads := SEMIGROUPS.DefaultOptionsRec.nr_threads,
+        benchmarks := results));
+
+  # Line breaking is switched off, since it would produce invalid JSON
+  if output = fail then
+    SetPrintFormattingStatus("*stdout*", false);
+    Print(json, "\n");
+  else
+    stream := OutputTextFile(output, false);
+    SetPrintFormattingStatus(stream, false);
+    PrintTo(stream, json, "\n");
+    CloseStream(stream);
+  fi;
+end;
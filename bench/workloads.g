@@ -0,0 +1,160 @@
+#############################################################################
+##
+##  bench/workloads.g
+##  Copyright (C) 2025                                   James D. Mitchell
+##
+##  Licensing information can be found in the README file of this package.
+##
+#############################################################################
+##
+## This file contains the workloads run by bench/bench.g. The micro
+## benchmarks call a single kernel function, or a GAP function which is a thin
+## wrapper around one, as directly as possible; the macro benchmarks are
+## typical computations. Every workload is built from fixed data, either the
+## files in data/ or random objects from a random source with a fixed seed,
+## so that the results for different commits can be compared.
+
+# The semigroup of degree 10 with 201 D-classes from
+# tst/standard/greens/acting.tst.
+SEMIGROUPS_BENCH.Trans10 := function()
+  return Semigroup([Transformation([2, 3, 6, 5, 4, 8, 10, 4, 1, 4]),
+                    Transformation([10, 2, 5, 4, 10, 3, 1, 6, 9, 6])],
+                   rec(acting := true));
+end;
+
+#############################################################################
+# Micro benchmarks
+#############################################################################
+
+# BIPART_PROD
+SEMIGROUPS_BENCH.Add("bipartition-products", "micro",
+function()
+  local rs;
+  rs := RandomSource(IsMersenneTwister, 1);
+  return List([1 .. 200], i -> RandomBipartition(rs, 20));
+end,
+function(xs)
+  local x, y, z;
+  for x in xs do
+    for y in xs do
+      z := x * y;
+    od;
+  od;
+  return Length(xs) ^ 2;
+end);
+
+# RUN_FROIDURE_PIN
+SEMIGROUPS_BENCH.Add("froidure-pin-fallback-size", "micro",
+function()
+  return Semigroup(FullMatrixMonoid(3, 3), rec(acting := false));
+end,
+Size);
+
+# LATTICE_OF_CONGRUENCES
+SEMIGROUPS_BENCH.Add("lattice-of-congruences-kernel", "micro",
+function()
+  return List(PrincipalCongruencesOfSemigroup(FullTransformationMonoid(4)),
+              EquivalenceRelationCanonicalLookup);
+end,
+lookups -> Length(libsemigroups.LATTICE_OF_CONGRUENCES(lookups)));
+
+# to_cpp
+SEMIGROUPS_BENCH.Add("to-cpp-transformations", "micro",
+function()
+  local S;
+  S := Semigroup(FullTransformationMonoid(6), rec(acting := false));
+  return [S, AsListCanonical(S)];
+end,
+function(data)
+  local S, x;
+  S := data[1];
+  for x in data[2] do
+    PositionCanonical(S, x);
+  od;
+  return Length(data[2]);
+end);
+
+# to_gap
+SEMIGROUPS_BENCH.Add("to-gap-transformations", "micro",
+function()
+  local S;
+  S := Semigroup(FullTransformationMonoid(6), rec(acting := false));
+  Size(S);
+  return S;
+end,
+S -> Length(AsListCanonical(S)));
+
+# TRANS_NR_IDEMPOTENTS
+SEMIGROUPS_BENCH.Add("trans-nr-idempotents", "micro",
+function()
+  local S;
+  S := Semigroup(FullTransformationMonoid(7), rec(acting := true));
+  Enumerate(LambdaOrb(S));
+  Enumerate(RhoOrb(S));
+  return S;
+end,
+NrIdempotents);
+
+# PARTIAL_ORDER_OF_DCLASSES
+SEMIGROUPS_BENCH.Add("partial-order-of-dclasses", "micro",
+function()
+  local S;
+  S := SEMIGROUPS_BENCH.Trans10();
+  GreensDClasses(S);
+  return S;
+end,
+S -> DigraphNrEdges(PartialOrderOfDClasses(S)));
+
+# ReadGenerators, for each of the files in data/gens
+Perform(["fullbool", "hall", "reflex", "reflex-6"],
+function(name)
+  SEMIGROUPS_BENCH.Add(Concatenation("read-generators-", name), "micro",
+  {} -> Concatenation(SEMIGROUPS.PackageDir, "/data/gens/", name,
+                      ".pickle.gz"),
+  filename -> Length(ReadGenerators(filename)));
+end);
+
+#############################################################################
+# Macro benchmarks
+#############################################################################
+
+SEMIGROUPS_BENCH.Add("size-full-boolean-mat-monoid-4", "macro",
+{} -> FullBooleanMatMonoid(4),
+Size);
+
+SEMIGROUPS_BENCH.Add("size-acting-transformations", "macro",
+SEMIGROUPS_BENCH.Trans10,
+Size);
+
+SEMIGROUPS_BENCH.Add("dclasses-acting-transformations", "macro",
+SEMIGROUPS_BENCH.Trans10,
+NrDClasses);
+
+SEMIGROUPS_BENCH.Add("dclasses-hall-monoid-4", "macro",
+{} -> HallMonoid(4),
+NrDClasses);
+
+SEMIGROUPS_BENCH.Add("congruences-multiplication-tables", "macro",
+function()
+  return ReadMultiplicationTable(Concatenation(SEMIGROUPS.PackageDir,
+                                               "/data/tst/tables.gz"));
+end,
+tables -> Sum(tables,
+              x -> Length(CongruencesOfSemigroup(
+                            SemigroupByMultiplicationTable(x)))));
+
+SEMIGROUPS_BENCH.Add("congruences-full-transformation-monoid-4", "macro",
+{} -> FullTransformationMonoid(4),
+S -> Length(CongruencesOfSemigroup(S)));
+
+SEMIGROUPS_BENCH.Add("congruences-symmetric-inverse-monoid-3", "macro",
+{} -> SymmetricInverseMonoid(3),
+S -> Length(CongruencesOfSemigroup(S)));
+
+SEMIGROUPS_BENCH.Add("sims1-right-congruences-reflexive-bool-3", "macro",
+{} -> ReflexiveBooleanMatMonoid(3),
+NumberOfRightCongruences);
+
+SEMIGROUPS_BENCH.Add("sims1-left-congruences-full-transformation-3", "macro",
+{} -> FullTransformationMonoid(3),
+NumberOfLeftCongruences);
@@ -1,4 +1,4 @@
 #!/bin/bash
 set -e
 
-gaplint --disable W004 *.g gap/options.g gap/*.gi gap/*.gd gap/*/* doc/*.xml tst/*.tst tst/*/*.tst tst/*/*/*.tst
+gaplint --disable W004 *.g bench/*.g gap/options.g gap/*.gi gap/*.gd gap/*/* doc/*.xml tst/*.tst tst/*/*.tst tst/*/*/*.tst
@@ -99,3 +99,8 @@ DeclareOperation("PrincipalRightCongruencesOfSemigroup",
                  [IsSemigroup, IsListOrCollection]);
 
 DeclareAttribute("GeneratingCongruencesOfJoinSemilattice", IsCongruencePoset);
+
+# The libsemigroups.CongruenceLattice object used to compute a congruence
+# poset, if any, this stores the lookups of all of the congruences in the
+# poset, and is used to compute joins and meets.
+DeclareAttribute("LibsemigroupsCongruenceLattice", IsCongruencePoset);
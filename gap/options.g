@@ -15,7 +15,9 @@ SEMIGROUPS.DefaultOptionsRec :=
       acting     := true,
       batch_size := 8192,
       nr_threads := 4,
-      cong_by_ker_trace_threshold := 10 ^ 5);
+      cong_by_ker_trace_threshold := 10 ^ 5,
+      cong_lattice_by_ker_trace_threshold := 1000,
+      cong_portfolio_budget := 0);
 
 SEMIGROUPS.ProcessOptionsRec := function(defaults, opts)
   local name;
@@ -15,3 +15,4 @@ DeclareGlobalFunction("IteratorFromGeneratorsFile");
 DeclareGlobalFunction("ReadMultiplicationTable");
 DeclareGlobalFunction("WriteMultiplicationTable");
 DeclareGlobalFunction("IteratorFromMultiplicationTableFile");
+DeclareGlobalFunction("PropertiesOfMultiplicationTableFile");
@@ -21,14 +21,15 @@
 
 #include "bipart.hpp"
 
-#include <algorithm>    // for fill, min, max, all_of, max_element
-#include <cstddef>      // for size_t, NULL
-#include <cstdint>      // for uint32_t
-#include <string>       // for string
-#include <thread>       // for thread
-#include <type_traits>  // for conditional<>::type
-#include <utility>      // for pair, make_pair
-#include <vector>       // for vector
+#include <algorithm>      // for fill, min, max, all_of, max_element
+#include <cstddef>        // for size_t, NULL
+#include <cstdint>        // for uint32_t
+#include <string>         // for string
+#include <thread>         // for thread
+#include <type_traits>    // for conditional<>::type
+#include <unordered_map>  // for unordered_map
+#include <utility>        // for pair, make_pair
+#include <vector>         // for vector
 
 // GAP headers
 #include "compiled.h"
@@ -48,8 +49,10 @@ using libsemigroups::detail::Timer;
 
 // Global variables
 
-static std::vector<size_t> _BUFFER_size_t;
-static std::vector<bool>   _BUFFER_bool;
+static std::vector<size_t>   _BUFFER_size_t;
+static std::vector<bool>     _BUFFER_bool;
+static std::vector<uint32_t> _BUFFER_key;
+static std::vector<uint32_t> _BUFFER_forget;
 
 // A T_BIPART Obj in GAP is of the form:
 //
@@ -72,18 +75,133 @@ Obj bipart_new_obj(Bipartition* x) {
 // A T_BLOCKS Obj in GAP is of the form:
 //
 //   [pointer to C++ blocks]
+//
+// The GAP blocks Objs are interned, i.e. there is at most one GAP blocks Obj
+// for every blocks. The table _BLOCKS_TABLE maps the key of every GAP blocks
+// Obj (see blocks_key) to the Obj, and an Obj is removed from the table by
+// blocks_forget when it is freed by the garbage collector, so that the table
+// only contains Objs that are alive. This means that the left and right blocks
+// of a bipartition, which are computed for every product in the enumeration of
+// a bipartition semigroup, are usually found in the table, and need not be
+// created at all.
+
+namespace {
+  struct BlocksKeyHash {
+    size_t operator()(std::vector<uint32_t> const& key) const {
+      size_t val = 0;
+      for (auto const& x : key) {
+        val ^= x + 0x9e3779b97f4a7c16 + (val << 6) + (val >> 2);
+      }
+      return val;
+    }
+  };
+}  // namespace
 
-// Returns the pointer to the C++ blocks object from the GAP bipartition
-// object.
+static std::unordered_map<std::vector<uint32_t>, Obj, BlocksKeyHash>
+    _BLOCKS_TABLE;
+
+// Sets key to the key of the C++ Blocks x, which consists of the degree of x,
+// the index of the block containing each point, and whether or not each block
+// is transverse.
+
+static void blocks_key(Blocks* x, std::vector<uint32_t>& key) {
+  key.clear();
+  key.push_back(x->degree());
+  key.insert(key.end(), x->cbegin(), x->cend());
+  key.insert(key.end(), x->cbegin_lookup(), x->cend_lookup());
+}
+
+// Sets key to the key of the left blocks of the C++ Bipartition x, without
+// creating them.
+
+static void left_blocks_key(Bipartition* x, std::vector<uint32_t>& key) {
+  size_t const deg     = x->degree();
+  size_t const nr_left = x->number_of_left_blocks();
+
+  key.clear();
+  key.push_back(deg);
+  key.insert(key.end(), x->cbegin(), x->cbegin() + deg);
+  key.resize(deg + 1 + nr_left, 0);
+  for (size_t i = deg; i < 2 * deg; i++) {
+    if (x->at(i) < nr_left) {
+      key[deg + 1 + x->at(i)] = 1;
+    }
+  }
+}
+
+// Sets key to the key of the right blocks of the C++ Bipartition x, without
+// creating them. The blocks are renumbered in the order that they occur, and a
+// block is transverse if and only if it is also one of the left blocks.
+
+static void right_blocks_key(Bipartition* x, std::vector<uint32_t>& key) {
+  size_t const deg     = x->degree();
+  size_t const nr_left = x->number_of_left_blocks();
+
+  _BUFFER_size_t.clear();
+  _BUFFER_size_t.resize(x->number_of_blocks(), -1);
+
+  key.clear();
+  key.push_back(deg);
+  size_t next = 0;
+  for (size_t i = deg; i < 2 * deg; i++) {
+    if (_BUFFER_size_t[x->at(i)] == static_cast<size_t>(-1)) {
+      _BUFFER_size_t[x->at(i)] = next;
+      next++;
+    }
+    key.push_back(_BUFFER_size_t[x->at(i)]);
+  }
+  key.resize(deg + 1 + next);
+  for (size_t i = deg; i < 2 * deg; i++) {
+    key[deg + 1 + _BUFFER_size_t[x->at(i)]] = (x->at(i) < nr_left ? 1 : 0);
+  }
+}
 
-// Create a new GAP blocks Obj from a C++ Blocks pointer.
+// Returns the GAP blocks Obj with key key, or NULL if there is no such Obj.
 
-inline Obj blocks_new_obj(Blocks* x) {
-  Obj o          = NewBag(T_BLOCKS, 1 * sizeof(Obj));
+static Obj blocks_find(std::vector<uint32_t> const& key) {
+  auto it = _BLOCKS_TABLE.find(key);
+  return (it == _BLOCKS_TABLE.end() ? NULL : it->second);
+}
+
+// Returns the GAP blocks Obj equal to the C++ Blocks pointer x, which is
+// deleted if there is already such an Obj, and otherwise belongs to the new
+// Obj.
+
+static Obj blocks_new_obj(Blocks* x) {
+  blocks_key(x, _BUFFER_key);
+  Obj o = blocks_find(_BUFFER_key);
+  if (o != NULL) {
+    delete x;
+    return o;
+  }
+  o              = NewBag(T_BLOCKS, 1 * sizeof(Obj));
   ADDR_OBJ(o)[0] = reinterpret_cast<Obj>(x);
+  // NewBag may trigger a garbage collection, and so call blocks_forget, which
+  // uses _BUFFER_forget and not _BUFFER_key for this reason.
+  _BLOCKS_TABLE.emplace(_BUFFER_key, o);
   return o;
 }
 
+// Adds the GAP blocks Obj o to the table of interned blocks, if there is not
+// already an Obj with the same key. This is used for GAP blocks Objs that are
+// not created by blocks_new_obj, i.e. those loaded from a workspace.
+
+void blocks_remember(Obj o) {
+  blocks_key(blocks_get_cpp(o), _BUFFER_key);
+  _BLOCKS_TABLE.emplace(_BUFFER_key, o);
+}
+
+// Removes the GAP blocks Obj o from the table of interned blocks, if it
+// belongs to it. This is called when o is freed by the garbage collector.
+
+void blocks_forget(Obj o) {
+  blocks_key(blocks_get_cpp(o), _BUFFER_forget);
+  auto it = _BLOCKS_TABLE.find(_BUFFER_forget);
+  if (it != _BLOCKS_TABLE.end() && it->second == o) {
+    _BLOCKS_TABLE.erase(it);
+  }
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 ////////////////////////////////////////////////////////////////////////////////
 // Bipartitions
@@ -622,12 +740,23 @@ Obj BIPART_STAB_ACTION(Obj self, Obj x, Obj p) {
 }
 
 // Returns the GAP Obj left block of the bipartition x. The left blocks are
-// simply the subpartition of [1 .. n] induced by x.
+// simply the subpartition of [1 .. n] induced by x. The left blocks are only
+// created if there is no existing GAP blocks Obj equal to them.
 
 Obj BIPART_LEFT_BLOCKS(Obj self, Obj x) {
   SEMIGROUPS_ASSERT(TNUM_OBJ(x) == T_BIPART);
   if (ADDR_OBJ(x)[1] == NULL) {
-    Obj o          = blocks_new_obj(bipart_get_cpp(x)->left_blocks());
+    Bipartition* xx = bipart_get_cpp(x);
+    left_blocks_key(xx, _BUFFER_key);
+    Obj o = blocks_find(_BUFFER_key);
+    if (o == NULL) {
+      o = blocks_new_obj(xx->left_blocks());
+    }
+#ifdef SEMIGROUPS_KERNEL_DEBUG
+    Blocks* expected = xx->left_blocks();
+    SEMIGROUPS_ASSERT(*expected == *blocks_get_cpp(o));
+    delete expected;
+#endif
     ADDR_OBJ(x)[1] = o;
     CHANGED_BAG(x);
   }
@@ -637,12 +766,23 @@ Obj BIPART_LEFT_BLOCKS(Obj self, Obj x) {
 }
 
 // Returns the GAP Obj right block of the bipartition x. The right blocks are
-// simply the subpartition of [-n .. -1] induced by x.
+// simply the subpartition of [-n .. -1] induced by x. The right blocks are
+// only created if there is no existing GAP blocks Obj equal to them.
 
 Obj BIPART_RIGHT_BLOCKS(Obj self, Obj x) {
   SEMIGROUPS_ASSERT(TNUM_OBJ(x) == T_BIPART);
   if (ADDR_OBJ(x)[2] == NULL) {
-    Obj o          = blocks_new_obj(bipart_get_cpp(x)->right_blocks());
+    Bipartition* xx = bipart_get_cpp(x);
+    right_blocks_key(xx, _BUFFER_key);
+    Obj o = blocks_find(_BUFFER_key);
+    if (o == NULL) {
+      o = blocks_new_obj(xx->right_blocks());
+    }
+#ifdef SEMIGROUPS_KERNEL_DEBUG
+    Blocks* expected = xx->right_blocks();
+    SEMIGROUPS_ASSERT(*expected == *blocks_get_cpp(o));
+    delete expected;
+#endif
     ADDR_OBJ(x)[2] = o;
     CHANGED_BAG(x);
   }
@@ -825,7 +965,7 @@ Int BLOCKS_EQ(Obj x, Obj y) {
   SEMIGROUPS_ASSERT(TNUM_OBJ(x) == T_BLOCKS);
   SEMIGROUPS_ASSERT(TNUM_OBJ(y) == T_BLOCKS);
 
-  return (*blocks_get_cpp(x) == *blocks_get_cpp(y) ? 1L : 0L);
+  return (x == y || *blocks_get_cpp(x) == *blocks_get_cpp(y) ? 1L : 0L);
 }
 
 // Check if x < y, when x and y are GAP blocks objects.
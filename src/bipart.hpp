@@ -46,6 +46,9 @@ inline libsemigroups::Blocks* blocks_get_cpp(Obj x) {
 
 Obj bipart_new_obj(libsemigroups::Bipartition*);
 
+void blocks_remember(Obj);
+void blocks_forget(Obj);
+
 // GAP level functions
 
 Int BIPART_EQ(Obj, Obj);
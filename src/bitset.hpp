@@ -0,0 +1,204 @@
+//
+// Semigroups package for GAP
+// Copyright (C) 2022 James D. Mitchell
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+
+// This file contains a simple dynamically sized bitset, used in several
+// places in the kernel module where the number of bits is only known at run
+// time, and so libsemigroups::BitSet (which has at most 64 bits) cannot be
+// used.
+
+#ifndef SEMIGROUPS_SRC_BITSET_HPP_
+#define SEMIGROUPS_SRC_BITSET_HPP_
+
+#include <algorithm>  // for fill, equal
+#include <cstddef>    // for size_t
+#include <cstdint>    // for uint64_t
+#include <vector>     // for vector
+
+#include "semigroups-debug.hpp"  // for SEMIGROUPS_ASSERT
+
+namespace semigroups {
+
+  class Bitset {
+    using block_type = uint64_t;
+
+    static constexpr size_t block_bits = 64;
+
+    std::vector<block_type> _blocks;
+    size_t                  _size;
+
+    static size_t nr_blocks(size_t n) noexcept {
+      return (n + block_bits - 1) / block_bits;
+    }
+
+   public:
+    static constexpr size_t npos = static_cast<size_t>(-1);
+
+    Bitset() : _blocks(), _size(0) {}
+
+    explicit Bitset(size_t n) : _blocks(nr_blocks(n), 0), _size(n) {}
+
+    Bitset(Bitset const&)            = default;
+    Bitset(Bitset&&)                 = default;
+    Bitset& operator=(Bitset const&) = default;
+    Bitset& operator=(Bitset&&)      = default;
+    ~Bitset()                        = default;
+
+    size_t size() const noexcept {
+      return _size;
+    }
+
+    void resize(size_t n) {
+      _blocks.assign(nr_blocks(n), 0);
+      _size = n;
+    }
+
+    bool get(size_t i) const noexcept {
+      SEMIGROUPS_ASSERT(i < _size);
+      return (_blocks[i / block_bits] >> (i % block_bits)) & 1;
+    }
+
+    void set(size_t i) noexcept {
+      SEMIGROUPS_ASSERT(i < _size);
+      _blocks[i / block_bits] |= block_type(1) << (i % block_bits);
+    }
+
+    void reset(size_t i) noexcept {
+      SEMIGROUPS_ASSERT(i < _size);
+      _blocks[i / block_bits] &= ~(block_type(1) << (i % block_bits));
+    }
+
+    void reset() noexcept {
+      std::fill(_blocks.begin(), _blocks.end(), 0);
+    }
+
+    void set() noexcept {
+      std::fill(_blocks.begin(), _blocks.end(), ~block_type(0));
+      if (_size % block_bits != 0) {
+        _blocks.back() = (block_type(1) << (_size % block_bits)) - 1;
+      }
+    }
+
+    bool none() const noexcept {
+      for (auto const& b : _blocks) {
+        if (b != 0) {
+          return false;
+        }
+      }
+      return true;
+    }
+
+    size_t count() const noexcept {
+      size_t result = 0;
+      for (auto const& b : _blocks) {
+        result += __builtin_popcountll(b);
+      }
+      return result;
+    }
+
+    // Sets *this to x & y, and returns true if the result is not empty.
+    bool intersection(Bitset const& x, Bitset const& y) noexcept {
+      SEMIGROUPS_ASSERT(x._size == y._size);
+      SEMIGROUPS_ASSERT(x._size == _size);
+      block_type any = 0;
+      for (size_t i = 0; i < _blocks.size(); ++i) {
+        _blocks[i] = x._blocks[i] & y._blocks[i];
+        any |= _blocks[i];
+      }
+      return any != 0;
+    }
+
+    Bitset& operator&=(Bitset const& that) noexcept {
+      SEMIGROUPS_ASSERT(_size == that._size);
+      for (size_t i = 0; i < _blocks.size(); ++i) {
+        _blocks[i] &= that._blocks[i];
+      }
+      return *this;
+    }
+
+    Bitset& operator|=(Bitset const& that) noexcept {
+      SEMIGROUPS_ASSERT(_size == that._size);
+      for (size_t i = 0; i < _blocks.size(); ++i) {
+        _blocks[i] |= that._blocks[i];
+      }
+      return *this;
+    }
+
+    // Resets every bit in *this that is set in that.
+    Bitset& operator-=(Bitset const& that) noexcept {
+      SEMIGROUPS_ASSERT(_size == that._size);
+      for (size_t i = 0; i < _blocks.size(); ++i) {
+        _blocks[i] &= ~that._blocks[i];
+      }
+      return *this;
+    }
+
+    bool operator==(Bitset const& that) const noexcept {
+      return _size == that._size
+             && std::equal(_blocks.cbegin(),
+                           _blocks.cend(),
+                           that._blocks.cbegin());
+    }
+
+    bool operator!=(Bitset const& that) const noexcept {
+      return !(*this == that);
+    }
+
+    // Returns true if every bit set in *this is also set in that.
+    bool is_subset_of(Bitset const& that) const noexcept {
+      SEMIGROUPS_ASSERT(_size == that._size);
+      for (size_t i = 0; i < _blocks.size(); ++i) {
+        if ((_blocks[i] & ~that._blocks[i]) != 0) {
+          return false;
+        }
+      }
+      return true;
+    }
+
+    // Returns the least i >= from such that the bit i is set, or npos if
+    // there is no such i.
+    size_t next(size_t from) const noexcept {
+      if (from >= _size) {
+        return npos;
+      }
+      size_t     i = from / block_bits;
+      block_type b = _blocks[i] & (~block_type(0) << (from % block_bits));
+      while (b == 0) {
+        if (++i == _blocks.size()) {
+          return npos;
+        }
+        b = _blocks[i];
+      }
+      return i * block_bits + __builtin_ctzll(b);
+    }
+
+    size_t first() const noexcept {
+      return next(0);
+    }
+
+    size_t hash() const noexcept {
+      size_t val = 0;
+      for (auto const& b : _blocks) {
+        val ^= b + 0x9e3779b97f4a7c16 + (val << 6) + (val >> 2);
+      }
+      return val;
+    }
+  };
+
+}  // namespace semigroups
+
+#endif  // SEMIGROUPS_SRC_BITSET_HPP_
@@ -18,13 +18,22 @@
 
 #include "cong.hpp"
 
+#include <algorithm>    // for min
+#include <atomic>       // for atomic
+#include <chrono>       // for nanoseconds, steady_clock
+#include <cstddef>      // for size_t
 #include <exception>    // for exception
+#include <functional>   // for function
 #include <memory>       // for shared_ptr
+#include <stdexcept>    // for runtime_error
+#include <string>       // for string, to_string
 #include <type_traits>  // for true_type
+#include <utility>      // for pair
 #include <vector>       // for vector
 
 // Semigroups GAP package headers
 #include "froidure-pin.hpp"  // for to_cpp<FroidurePin<Bipartition>
+#include "parallel.hpp"      // for number_of_threads, parallel_for
 #include "pkg.hpp"           // for IsGapBind14Type
 #include "to_cpp.hpp"        // for to_cpp
 #include "to_gap.hpp"        // for to_gap
@@ -36,15 +45,17 @@
 #include "gapbind14/gapbind14.hpp"  // for class_ etc
 
 // libsemigroups headers
-#include "libsemigroups/bipart.hpp"        // for Bipartition
-#include "libsemigroups/cong-intf.hpp"     // for congruence_kind
-#include "libsemigroups/cong.hpp"          // for Congruence
-#include "libsemigroups/constants.hpp"     // for UNDEFINED etc
-#include "libsemigroups/froidure-pin.hpp"  // for FroidurePin
-#include "libsemigroups/matrix.hpp"        // for BMat etc
-#include "libsemigroups/todd-coxeter.hpp"  // for ToddCoxeter
-#include "libsemigroups/transf.hpp"        // for PPerm etc
-#include "libsemigroups/types.hpp"         // for word_type
+#include "libsemigroups/bipart.hpp"             // for Bipartition
+#include "libsemigroups/cong-intf.hpp"          // for congruence_kind
+#include "libsemigroups/cong.hpp"               // for Congruence
+#include "libsemigroups/constants.hpp"          // for UNDEFINED etc
+#include "libsemigroups/froidure-pin-base.hpp"  // for FroidurePinBase
+#include "libsemigroups/froidure-pin.hpp"       // for FroidurePin
+#include "libsemigroups/knuth-bendix.hpp"       // for KnuthBendix
+#include "libsemigroups/matrix.hpp"             // for BMat etc
+#include "libsemigroups/todd-coxeter.hpp"       // for ToddCoxeter
+#include "libsemigroups/transf.hpp"             // for PPerm etc
+#include "libsemigroups/types.hpp"              // for word_type
 
 // Forward decls
 namespace libsemigroups {
@@ -52,18 +63,470 @@ namespace libsemigroups {
   class PBR;
 }  // namespace libsemigroups
 
+namespace semigroups {
+  class CongruencePortfolio;
+}  // namespace semigroups
+
 namespace gapbind14 {
   template <>
   struct IsGapBind14Type<libsemigroups::Congruence> : std::true_type {};
 
+  template <>
+  struct IsGapBind14Type<semigroups::CongruencePortfolio> : std::true_type {};
+
 }  // namespace gapbind14
 
+////////////////////////////////////////////////////////////////////////
+// CongruencePortfolio
+////////////////////////////////////////////////////////////////////////
+
+namespace semigroups {
+
+  // This class runs several differently configured runners (ToddCoxeter with
+  // various strategies and lookaheads, and KnuthBendix) for the same
+  // congruence in parallel. The first runner to finish wins, and all of the
+  // others are killed. The winner can then be added to a
+  // libsemigroups::Congruence created with no runners of its own.
+  class CongruencePortfolio {
+    using Congruence          = libsemigroups::Congruence;
+    using CongruenceInterface = libsemigroups::CongruenceInterface;
+    using KnuthBendix         = libsemigroups::congruence::KnuthBendix;
+    using ToddCoxeter         = libsemigroups::congruence::ToddCoxeter;
+    using congruence_kind     = libsemigroups::congruence_kind;
+    using word_type           = libsemigroups::word_type;
+
+    struct Entry {
+      std::string                          name;
+      std::shared_ptr<CongruenceInterface> runner;
+      // Adds a copy of runner to a Congruence, this is required because
+      // Congruence::add_runner must know the type of the runner.
+      std::function<void(Congruence&)> add_to;
+    };
+
+    congruence_kind                              _kind;
+    size_t                                       _nr_gens;
+    std::vector<std::pair<word_type, word_type>> _pairs;
+    std::vector<Entry>                           _runners;
+    bool                                         _started;
+    std::chrono::nanoseconds                     _time;
+    size_t                                       _winner;
+
+    void validate_not_started() const {
+      if (_started) {
+        throw std::runtime_error("cannot modify the portfolio after it has "
+                                 "been run");
+      }
+    }
+
+    // The generators and pairs are added to every runner exactly once, either
+    // here, or in set_number_of_generators and add_pair if the runner was
+    // added first.
+    template <typename T>
+    void add(std::string const& name, std::shared_ptr<T> r) {
+      validate_not_started();
+      if (_nr_gens != libsemigroups::UNDEFINED
+          && r->number_of_generators() == libsemigroups::UNDEFINED) {
+        r->set_number_of_generators(_nr_gens);
+      }
+      for (auto const& pair : _pairs) {
+        r->add_pair(pair.first, pair.second);
+      }
+      _runners.push_back({name, r, [r](Congruence& C) { C.add_runner(*r); }});
+    }
+
+    static ToddCoxeter::options::strategy to_strategy(std::string const& x) {
+      using strategy = ToddCoxeter::options::strategy;
+      if (x == "hlt") {
+        return strategy::hlt;
+      } else if (x == "felsch") {
+        return strategy::felsch;
+      } else if (x == "CR") {
+        return strategy::CR;
+      } else if (x == "R/C") {
+        return strategy::R_over_C;
+      } else if (x == "Cr") {
+        return strategy::Cr;
+      } else if (x == "Rc") {
+        return strategy::Rc;
+      }
+      throw std::runtime_error("expected one of \"hlt\", \"felsch\", \"CR\", "
+                               "\"R/C\", \"Cr\", or \"Rc\", found \""
+                               + x + "\"");
+    }
+
+    static ToddCoxeter::options::lookahead to_lookahead(std::string const& x) {
+      using lookahead = ToddCoxeter::options::lookahead;
+      lookahead extent;
+      if (x == "full") {
+        extent = lookahead::full;
+      } else if (x == "partial") {
+        extent = lookahead::partial;
+      } else {
+        throw std::runtime_error(
+            "expected \"full\" or \"partial\", found \"" + x + "\"");
+      }
+      return static_cast<lookahead>(static_cast<int>(extent)
+                                    | static_cast<int>(lookahead::hlt));
+    }
+
+   public:
+    explicit CongruencePortfolio(congruence_kind knd)
+        : _kind(knd),
+          _nr_gens(libsemigroups::UNDEFINED),
+          _pairs(),
+          _runners(),
+          _started(false),
+          _time(0),
+          _winner(libsemigroups::UNDEFINED) {}
+
+    void set_number_of_generators(size_t n) {
+      validate_not_started();
+      _nr_gens = n;
+      for (auto& entry : _runners) {
+        if (entry.runner->number_of_generators() == libsemigroups::UNDEFINED) {
+          entry.runner->set_number_of_generators(n);
+        }
+      }
+    }
+
+    void add_pair(word_type const& u, word_type const& v) {
+      validate_not_started();
+      if (_nr_gens == libsemigroups::UNDEFINED) {
+        throw std::runtime_error("the number of generators is not defined");
+      }
+      for (auto& entry : _runners) {
+        entry.runner->add_pair(u, v);
+      }
+      _pairs.emplace_back(u, v);
+    }
+
+    size_t number_of_runners() const noexcept {
+      return _runners.size();
+    }
+
+    // Adds a copy of <tc> using the strategy and lookahead extent with the
+    // given names.
+    void add_todd_coxeter(ToddCoxeter const& tc,
+                          std::string const& strategy,
+                          std::string const& lookahead) {
+      if (tc.kind() != _kind) {
+        throw std::runtime_error("the ToddCoxeter instance has the wrong "
+                                 "congruence kind");
+      }
+      auto r = std::make_shared<ToddCoxeter>(tc);
+      r->strategy(to_strategy(strategy)).lookahead(to_lookahead(lookahead));
+      add("todd_coxeter(" + strategy + ", " + lookahead + ")", r);
+    }
+
+    void add_knuth_bendix() {
+      if (_kind != congruence_kind::twosided) {
+        throw std::runtime_error("KnuthBendix can only be used for 2-sided "
+                                 "congruences");
+      }
+      add("knuth_bendix", std::make_shared<KnuthBendix>());
+    }
+
+    // Runs the runners in parallel using <nr_threads> threads (capped at the
+    // number of hardware threads), each for at most <ms> milliseconds.
+    // Returns true if some runner finished.
+    //
+    // If <ms> is 0, then the runners are run without a time limit, and so only
+    // the first <nr_threads> runners ever start, since the remaining runners
+    // are only started after one of these has finished. In particular, if
+    // only 1 thread is available, then there is no race at all, and false is
+    // returned without running anything, so that the caller can use a single
+    // runner instead.
+    bool run_for(size_t ms, size_t nr_threads) {
+      using libsemigroups::UNDEFINED;
+      nr_threads = semigroups::number_of_threads(nr_threads);
+      if (_winner != UNDEFINED) {
+        return true;
+      } else if (_nr_gens == UNDEFINED) {
+        throw std::runtime_error("the number of generators is not defined");
+      } else if (ms == 0 && nr_threads == 1) {
+        return false;
+      }
+      _started = true;
+
+      size_t const        none = UNDEFINED;
+      std::atomic<size_t> winner(none);
+      auto const          start = std::chrono::steady_clock::now();
+
+      parallel_for(_runners.size(), nr_threads, [&](size_t i) {
+        auto& r = *_runners[i].runner;
+        if (winner.load() != none) {
+          return;
+        }
+        // A runner that throws (for example, because its strategy is not
+        // compatible with a prefilled table) simply loses the race.
+        try {
+          if (ms == 0) {
+            r.run();
+          } else {
+            r.run_for(std::chrono::milliseconds(ms));
+          }
+        } catch (std::exception const&) {
+          return;
+        }
+        size_t expected = none;
+        if (r.finished() && winner.compare_exchange_strong(expected, i)) {
+          _time = std::chrono::duration_cast<std::chrono::nanoseconds>(
+              std::chrono::steady_clock::now() - start);
+          for (size_t j = 0; j < _runners.size(); ++j) {
+            if (j != i) {
+              _runners[j].runner->kill();
+            }
+          }
+        }
+      });
+      _winner = winner.load();
+      return _winner != none;
+    }
+
+    bool has_winner() const noexcept {
+      return _winner != libsemigroups::UNDEFINED;
+    }
+
+    std::string winner() const {
+      validate_winner();
+      return _runners[_winner].name;
+    }
+
+    // Returns the time (in nanoseconds) taken by the winner.
+    size_t winner_time() const {
+      validate_winner();
+      return _time.count();
+    }
+
+    void add_winner_to(Congruence& C) const {
+      validate_winner();
+      if (C.kind() != _kind) {
+        throw std::runtime_error("the congruence has the wrong kind");
+      }
+      _runners[_winner].add_to(C);
+    }
+
+   private:
+    void validate_winner() const {
+      if (!has_winner()) {
+        throw std::runtime_error("no runner in the portfolio has finished");
+      }
+    }
+  };
+
+}  // namespace semigroups
+
 ////////////////////////////////////////////////////////////////////////
 // Congruence
 ////////////////////////////////////////////////////////////////////////
 
 using gapbind14::overload_cast;
 
+namespace {
+  // Returns the index of the class of every element of the parent
+  // FroidurePin of <C>, in the order that the elements were enumerated.
+  std::vector<size_t> class_indices(libsemigroups::Congruence& C) {
+    if (!C.has_parent_froidure_pin()) {
+      throw std::runtime_error(
+          "the argument (a congruence) must have a parent FroidurePin");
+    }
+    auto                     fp = C.parent_froidure_pin();
+    size_t const             n  = fp->size();
+    std::vector<size_t>      result(n);
+    libsemigroups::word_type w;
+    for (size_t i = 0; i < n; ++i) {
+      fp->minimal_factorisation(w, i);
+      result[i] = C.word_to_class_index(w);
+    }
+    return result;
+  }
+
+  // Adds the generating pairs in the GAP list <pairs> to <C>, where each pair
+  // consists of the positions (plus 1) of two elements in the parent
+  // FroidurePin of <C>.
+  void add_pairs_by_position(libsemigroups::Congruence& C, Obj pairs) {
+    if (!C.has_parent_froidure_pin()) {
+      throw std::runtime_error(
+          "the 1st argument (a congruence) must have a parent FroidurePin");
+    } else if (!IS_LIST(pairs)) {
+      throw std::runtime_error("the 2nd argument must be a list");
+    }
+    auto                     fp = C.parent_froidure_pin();
+    size_t const             n  = fp->size();
+    libsemigroups::word_type u, v;
+    for (size_t i = 1; i <= static_cast<size_t>(LEN_LIST(pairs)); ++i) {
+      Obj pair = ELM_LIST(pairs, i);
+      if (!IS_LIST(pair) || LEN_LIST(pair) != 2) {
+        throw std::runtime_error(
+            "the 2nd argument must consist of lists of length 2");
+      }
+      Obj x = ELM_LIST(pair, 1);
+      Obj y = ELM_LIST(pair, 2);
+      if (!IS_INTOBJ(x) || !IS_INTOBJ(y) || INT_INTOBJ(x) < 1
+          || INT_INTOBJ(y) < 1 || static_cast<size_t>(INT_INTOBJ(x)) > n
+          || static_cast<size_t>(INT_INTOBJ(y)) > n) {
+        throw std::runtime_error("the 2nd argument must consist of pairs of "
+                                 "integers in the range [1, "
+                                 + std::to_string(n) + "]");
+      }
+      fp->minimal_factorisation(u, INT_INTOBJ(x) - 1);
+      fp->minimal_factorisation(v, INT_INTOBJ(y) - 1);
+      C.add_pair(u, v);
+    }
+  }
+
+  // Returns the GAP list whose i-th entry is the class index (plus 1) of the
+  // i-th element of the parent FroidurePin of <C>. If <canonical> is true,
+  // then the classes are renumbered in the order of their first elements,
+  // i.e. the result is the EquivalenceRelationCanonicalLookup of the
+  // congruence.
+  Obj lookup(libsemigroups::Congruence& C, bool canonical) {
+    using libsemigroups::UNDEFINED;
+    std::vector<size_t> const index = class_indices(C);
+    std::vector<size_t>       renumber(canonical ? C.number_of_classes() : 0,
+                                       static_cast<size_t>(UNDEFINED));
+    size_t                    next = 0;
+
+    Obj result = NEW_PLIST(T_PLIST_CYC, index.size());
+    SET_LEN_PLIST(result, index.size());
+    for (size_t i = 0; i < index.size(); ++i) {
+      size_t val = index[i];
+      if (canonical) {
+        if (renumber[val] == static_cast<size_t>(UNDEFINED)) {
+          renumber[val] = next++;
+        }
+        val = renumber[val];
+      }
+      SET_ELM_PLIST(result, i + 1, INTOBJ_INT(val + 1));
+    }
+    return result;
+  }
+
+  // Returns the GAP list of the class indices (plus 1) of <words> in <C>. If
+  // <C> has finished using ToddCoxeter, then the indices are computed using
+  // <nr_threads> threads.
+  Obj class_indices_of_words(libsemigroups::Congruence&                  C,
+                             std::vector<libsemigroups::word_type> const& words,
+                             size_t nr_threads) {
+    Obj result = NEW_PLIST(T_PLIST_CYC, words.size());
+    SET_LEN_PLIST(result, words.size());
+    if (words.empty()) {
+      RetypeBag(result, T_PLIST_EMPTY);
+      return result;
+    }
+    std::vector<size_t> index(words.size());
+    // The first call runs <C> (if necessary), and standardizes the table of
+    // ToddCoxeter, after which the remaining calls to ToddCoxeter only read
+    // its table. Once <C> has finished, the winner is its only runner. Other
+    // runners, such as KnuthBendix, compute the indices in data that they
+    // build on demand, and so are never called concurrently.
+    index[0]   = C.word_to_class_index(words[0]);
+    nr_threads = semigroups::number_of_threads(nr_threads);
+    if (C.finished() && C.has_todd_coxeter() && nr_threads > 1) {
+      size_t const chunk     = 1024;
+      size_t const nr_chunks = (words.size() + chunk - 2) / chunk;
+      semigroups::parallel_for(nr_chunks, nr_threads, [&](size_t k) {
+        size_t const last = std::min(words.size(), (k + 1) * chunk + 1);
+        for (size_t i = k * chunk + 1; i < last; ++i) {
+          index[i] = C.word_to_class_index(words[i]);
+        }
+      });
+    } else {
+      for (size_t i = 1; i < words.size(); ++i) {
+        index[i] = C.word_to_class_index(words[i]);
+      }
+    }
+    for (size_t i = 0; i < index.size(); ++i) {
+      SET_ELM_PLIST(result, i + 1, INTOBJ_INT(index[i] + 1));
+    }
+    return result;
+  }
+
+  // Returns the GAP list of the class indices (plus 1) of the words in the
+  // GAP list <words>, where the letters of every word are the positions
+  // (plus 1) of the generators of <C>.
+  Obj word_to_class_index_batch(libsemigroups::Congruence& C,
+                                Obj                        words,
+                                size_t                     nr_threads) {
+    if (!IS_LIST(words)) {
+      throw std::runtime_error("the 2nd argument must be a list");
+    }
+    size_t const n = C.number_of_generators();
+    std::vector<libsemigroups::word_type> cpp_words(LEN_LIST(words));
+    for (size_t i = 0; i < cpp_words.size(); ++i) {
+      Obj word = ELM_LIST(words, i + 1);
+      if (!IS_LIST(word)) {
+        throw std::runtime_error("the 2nd argument must consist of lists");
+      }
+      cpp_words[i].resize(LEN_LIST(word));
+      for (size_t j = 0; j < cpp_words[i].size(); ++j) {
+        Obj x = ELM_LIST(word, j + 1);
+        if (!IS_INTOBJ(x) || INT_INTOBJ(x) < 1
+            || static_cast<size_t>(INT_INTOBJ(x)) > n) {
+          throw std::runtime_error("the 2nd argument must consist of lists "
+                                   "of integers in the range [1, "
+                                   + std::to_string(n) + "]");
+        }
+        cpp_words[i][j] = INT_INTOBJ(x) - 1;
+      }
+    }
+    return class_indices_of_words(C, cpp_words, nr_threads);
+  }
+
+  // Returns the GAP list of the class indices (plus 1) of the elements of
+  // the parent FroidurePin of <C> whose positions (plus 1) are given in the
+  // GAP list <positions>.
+  Obj position_to_class_index_batch(libsemigroups::Congruence& C,
+                                    Obj                        positions,
+                                    size_t                     nr_threads) {
+    if (!C.has_parent_froidure_pin()) {
+      throw std::runtime_error(
+          "the 1st argument (a congruence) must have a parent FroidurePin");
+    } else if (!IS_LIST(positions)) {
+      throw std::runtime_error("the 2nd argument must be a list");
+    }
+    auto         fp = C.parent_froidure_pin();
+    size_t const n  = fp->size();
+    std::vector<libsemigroups::word_type> words(LEN_LIST(positions));
+    for (size_t i = 0; i < words.size(); ++i) {
+      Obj x = ELM_LIST(positions, i + 1);
+      if (!IS_INTOBJ(x) || INT_INTOBJ(x) < 1
+          || static_cast<size_t>(INT_INTOBJ(x)) > n) {
+        throw std::runtime_error("the 2nd argument must consist of integers "
+                                 "in the range [1, "
+                                 + std::to_string(n) + "]");
+      }
+      fp->minimal_factorisation(words[i], INT_INTOBJ(x) - 1);
+    }
+    return class_indices_of_words(C, words, nr_threads);
+  }
+
+  // Returns the non-trivial classes of <C> as GAP lists of the positions
+  // (plus 1) of their elements in the parent FroidurePin of <C>. The classes
+  // are in the same order as those returned by Congruence::cbegin_ntc.
+  Obj ntc_positions(libsemigroups::Congruence& C) {
+    std::vector<size_t> const        index = class_indices(C);
+    std::vector<std::vector<size_t>> classes(C.number_of_classes());
+    for (size_t i = 0; i < index.size(); ++i) {
+      classes[index[i]].push_back(i);
+    }
+
+    Obj result = NEW_PLIST(T_PLIST, 0);
+    for (auto const& class_ : classes) {
+      if (class_.size() < 2) {
+        continue;
+      }
+      Obj list = NEW_PLIST(T_PLIST_CYC, class_.size());
+      SET_LEN_PLIST(list, class_.size());
+      for (size_t j = 0; j < class_.size(); ++j) {
+        SET_ELM_PLIST(list, j + 1, INTOBJ_INT(class_[j] + 1));
+      }
+      PushPlist(result, list);
+    }
+    return result;
+  }
+}  // namespace
+
 void init_cong(gapbind14::Module& m) {
   using libsemigroups::Congruence;
   using libsemigroups::congruence_kind;
@@ -142,5 +605,31 @@ void init_cong(gapbind14::Module& m) {
            [](Congruence& C) {
              return gapbind14::make_iterator(C.cbegin_ntc(), C.cend_ntc());
            })
-      .def("quotient_froidure_pin", &Congruence::quotient_froidure_pin);
+      .def("quotient_froidure_pin", &Congruence::quotient_froidure_pin)
+      .def("add_pairs_by_position", &add_pairs_by_position)
+      .def("ntc_positions", &ntc_positions)
+      .def("lookup", [](Congruence& C) { return lookup(C, false); })
+      .def("canonical_lookup", [](Congruence& C) { return lookup(C, true); })
+      .def("word_to_class_index_batch", &word_to_class_index_batch)
+      .def("position_to_class_index_batch", &position_to_class_index_batch)
+      .def("has_parent_froidure_pin", &Congruence::has_parent_froidure_pin)
+      .def("add_portfolio_winner",
+           [](Congruence& C, semigroups::CongruencePortfolio const& P) {
+             P.add_winner_to(C);
+           });
+
+  using semigroups::CongruencePortfolio;
+
+  gapbind14::class_<CongruencePortfolio>("CongruencePortfolio")
+      .def(gapbind14::init<congruence_kind>{}, "make")
+      .def("set_number_of_generators",
+           &CongruencePortfolio::set_number_of_generators)
+      .def("add_pair", &CongruencePortfolio::add_pair)
+      .def("number_of_runners", &CongruencePortfolio::number_of_runners)
+      .def("add_todd_coxeter", &CongruencePortfolio::add_todd_coxeter)
+      .def("add_knuth_bendix", &CongruencePortfolio::add_knuth_bendix)
+      .def("run_for", &CongruencePortfolio::run_for)
+      .def("has_winner", &CongruencePortfolio::has_winner)
+      .def("winner", &CongruencePortfolio::winner)
+      .def("winner_time", &CongruencePortfolio::winner_time);
 }
@@ -18,28 +18,48 @@
 
 // This file contains a function LATTICE_OF_CONGRUENCES for finding the lattice
 // of congruences when there are too many generating congruences for
-// Froidure-Pin to handle.
+// Froidure-Pin to handle, functions PRINCIPAL_CONGRUENCES and
+// ALL_PRINCIPAL_CONGRUENCES for finding the distinct principal (left, right,
+// or 2-sided) congruences generated by a list of pairs, or by all pairs, a
+// function POSET_OF_CONGRUENCES for finding the containments
+// between a list of congruences, and the bindings for the classes
+// CongruenceLattice, which stores the join semilattice generated by a list of
+// congruences and computes its joins and meets, and InverseCongruenceLattice,
+// which computes the lattice of congruences of an inverse semigroup by
+// kernels and traces.
 
 #include "conglatt.hpp"
 
-#include <algorithm>      // for equal, max
-#include <chrono>         // for time_point
-#include <cmath>          // for log2
-#include <cstddef>        // for size_t
-#include <cstdint>        // for uint16_t, uint32_t
-#include <iostream>       // for cout
-#include <memory>         // for unique_ptr
-#include <numeric>        // for iota
-#include <unordered_map>  // for unordered_map
-#include <utility>        // for swap, pair
-#include <vector>         // for vector
+#include <algorithm>         // for equal, max, min, stable_sort
+#include <chrono>            // for time_point
+#include <cmath>             // for log2
+#include <cstddef>           // for size_t
+#include <cstdint>           // for uint8_t, uint16_t, uint32_t
+#include <exception>         // for exception_ptr, rethrow_exception
+#include <initializer_list>  // for initializer_list
+#include <iostream>          // for cout
+#include <memory>            // for unique_ptr
+#include <numeric>           // for iota
+#include <stdexcept>         // for runtime_error
+#include <string>            // for to_string
+#include <tuple>             // for tie
+#include <type_traits>       // for true_type
+#include <unordered_map>     // for unordered_map
+#include <utility>           // for swap, pair
+#include <vector>            // for vector
 
 // GAP headers
 #include "compiled.h"
 
 // Semigroups package for GAP headers
+#include "bitset.hpp"            // for Bitset
+#include "parallel.hpp"          // for number_of_threads, parallel_for
+#include "pkg.hpp"               // for IsGapBind14Type
 #include "semigroups-debug.hpp"  // for SEMIGROUPS_ASSERT
 
+// GapBind14 headers
+#include "gapbind14/gapbind14.hpp"  // for class_
+
 // libsemigroups headers
 #include "libsemigroups/adapters.hpp"  // for Hash
 #include "libsemigroups/report.hpp"    // for should_report
@@ -114,6 +134,10 @@ namespace semigroups {
                           _data.cend());
       }
 
+      void reset() {
+        std::iota(_data.begin(), _data.end(), 0);
+      }
+
       void normalize() {
         for (index_type i = 0; i < _data.size(); ++i) {
           _data[i] = find(_data[i]);
@@ -130,6 +154,31 @@ namespace semigroups {
         normalize();
       }
 
+      // Sets *this to the intersection of <x> and <y>, both of which must be
+      // normalized.
+      void meet(UF const& x, UF const& y) {
+        SEMIGROUPS_ASSERT(size() == x.size());
+        SEMIGROUPS_ASSERT(size() == y.size());
+        std::unordered_map<uint64_t, index_type> first;
+        uint64_t const                           n = _data.size();
+        for (index_type i = 0; i < _data.size(); ++i) {
+          uint64_t const key = x._data[i] * n + y._data[i];
+          _data[i]           = first.emplace(key, i).first->second;
+        }
+      }
+
+      // Returns true if every pair in *this also belongs to <that>, both of
+      // which must be normalized.
+      bool is_subset_of(UF const& that) const {
+        SEMIGROUPS_ASSERT(size() == that.size());
+        for (index_type i = 0; i < _data.size(); ++i) {
+          if (that._data[_data[i]] != that._data[i]) {
+            return false;
+          }
+        }
+        return true;
+      }
+
       size_t hash() const {
         size_t val = 0;
         for (auto it = _data.cbegin(); it < _data.cend();
@@ -142,11 +191,67 @@ namespace semigroups {
       size_t size() const noexcept {
         return _data.size();
       }
+
+      // Only valid after normalize has been called.
+      node_type operator[](index_type i) const {
+        SEMIGROUPS_ASSERT(i < _data.size());
+        return _data[i];
+      }
+
+      // Only valid after normalize has been called.
+      size_t number_of_blocks() const noexcept {
+        size_t result = 0;
+        for (index_type i = 0; i < _data.size(); ++i) {
+          result += (_data[i] == i);
+        }
+        return result;
+      }
+    };
+
+    // A congruence on a finite inverse semigroup, given by its kernel (the
+    // elements related to an idempotent, as a subset of the positions of the
+    // elements) and its trace (its restriction to the idempotents, as a
+    // partition of the indices of the idempotents).
+    struct KernelTrace {
+      Bitset       kernel;
+      UF<uint16_t> trace;
+
+      KernelTrace(size_t n, size_t k) : kernel(n), trace(k) {}
+
+      bool operator==(KernelTrace const& that) const {
+        return kernel == that.kernel && trace == that.trace;
+      }
+
+      // Both traces must be normalized.
+      bool is_subset_of(KernelTrace const& that) const {
+        return kernel.is_subset_of(that.kernel)
+               && trace.is_subset_of(that.trace);
+      }
+
+      size_t hash() const {
+        size_t const val = kernel.hash();
+        return val ^ (trace.hash() + 0x9e3779b97f4a7c16 + (val << 6));
+      }
     };
   }  // namespace
 }  // namespace semigroups
 
 namespace libsemigroups {
+  template <>
+  struct Hash<semigroups::KernelTrace*> {
+    size_t operator()(semigroups::KernelTrace* x) const {
+      return x->hash();
+    }
+  };
+
+  template <>
+  struct EqualTo<semigroups::KernelTrace*> {
+    size_t operator()(semigroups::KernelTrace* x,
+                      semigroups::KernelTrace* y) const {
+      return *x == *y;
+    }
+  };
+
   template <typename T>
   struct Hash<semigroups::UF<T>*> {
     size_t operator()(semigroups::UF<T>* x) const {
@@ -186,90 +291,1251 @@ namespace semigroups {
       }
       return uf;
     }
+
+    // Converts the GAP list <graph> of length <n> of lists of length <m> (a
+    // right or left Cayley graph) into a flat vector of 0-based values.
+    std::vector<uint32_t> to_cayley_graph(Obj graph, size_t n, size_t m) {
+      if (!IS_LIST(graph) || static_cast<size_t>(LEN_LIST(graph)) != n) {
+        throw std::runtime_error("expected a list of length "
+                                 + std::to_string(n));
+      }
+      std::vector<uint32_t> result;
+      result.reserve(n * m);
+      for (size_t i = 1; i <= n; ++i) {
+        Obj row = ELM_LIST(graph, i);
+        if (!IS_LIST(row) || static_cast<size_t>(LEN_LIST(row)) != m) {
+          throw std::runtime_error("expected a list of length "
+                                   + std::to_string(m));
+        }
+        for (size_t a = 1; a <= m; ++a) {
+          Obj val = ELM_LIST(row, a);
+          if (!IS_INTOBJ(val) || INT_INTOBJ(val) < 1
+              || static_cast<size_t>(INT_INTOBJ(val)) > n) {
+            throw std::runtime_error("expected an integer in the range [1, "
+                                     + std::to_string(n) + "]");
+          }
+          result.push_back(INT_INTOBJ(val) - 1);
+        }
+      }
+      return result;
+    }
+
+    // Unites everything in <uf> forced by the pairs in <stack>, which must
+    // already be united in <uf>, by following the edges of the flat Cayley
+    // graphs <right> and <left> (either of which may be empty) with <m>
+    // generators. The stack is empty on return.
+    template <typename UF>
+    void close(UF&                                         uf,
+               std::vector<uint32_t> const&                right,
+               std::vector<uint32_t> const&                left,
+               size_t                                      m,
+               std::vector<std::pair<uint32_t, uint32_t>>& stack) {
+      uint32_t x, y;
+      while (!stack.empty()) {
+        std::tie(x, y) = stack.back();
+        stack.pop_back();
+        for (auto const* graph : {&right, &left}) {
+          if (graph->empty()) {
+            continue;
+          }
+          for (size_t a = 0; a < m; ++a) {
+            uint32_t const xx = (*graph)[x * m + a];
+            uint32_t const yy = (*graph)[y * m + a];
+            if (uf.find(xx) != uf.find(yy)) {
+              uf.unite(xx, yy);
+              stack.emplace_back(xx, yy);
+            }
+          }
+        }
+      }
+      uf.normalize();
+    }
+
+    // Unites <x> and <y> in <uf>, and then everything that this forces.
+    template <typename UF>
+    void close(UF&                          uf,
+               std::vector<uint32_t> const& right,
+               std::vector<uint32_t> const& left,
+               size_t                       m,
+               uint32_t                     x,
+               uint32_t                     y) {
+      std::vector<std::pair<uint32_t, uint32_t>> stack;
+      stack.emplace_back(x, y);
+      uf.unite(x, y);
+      close(uf, right, left, m, stack);
+    }
   }  // namespace
 
-  Obj LATTICE_OF_CONGRUENCES(Obj list) {
-    using UF = UF<uint16_t>;
+  ////////////////////////////////////////////////////////////////////////
+  // CongruenceLattice
+  ////////////////////////////////////////////////////////////////////////
 
-    using libsemigroups::EqualTo;
-    using libsemigroups::Hash;
-    using libsemigroups::detail::group_digits;
+  // This class stores the join semilattice generated by a list of
+  // congruences (given by their lookups) and the trivial congruence, so that
+  // joins and meets of its elements can be computed without recreating any
+  // GAP congruences.
+  class CongruenceLattice {
+    using uf_type  = UF<uint16_t>;
+    using map_type = std::unordered_map<uf_type*,
+                                        uint32_t,
+                                        libsemigroups::Hash<uf_type*>,
+                                        libsemigroups::EqualTo<uf_type*>>;
 
-    using std::chrono::duration_cast;
-    using std::chrono::nanoseconds;
-    using std::chrono::seconds;
+    std::vector<uint32_t>                 _cayley_graph;
+    std::vector<std::unique_ptr<uf_type>> _elements;
+    std::vector<uf_type>                  _gens;
+    map_type                              _map;
 
-    if (LEN_LIST(list) == 0) {
-      ErrorQuit(
-          "the argument must be a list of length at least 1, found 0", 0L, 0L);
+    // Returns the position of <x> in _elements, or throws if <x> does not
+    // belong to the semilattice.
+    uint32_t position(uf_type& x) const {
+      auto it = _map.find(&x);
+      if (it == _map.end()) {
+        throw std::runtime_error("the congruence does not belong to the "
+                                 "semilattice");
+      }
+      return it->second;
     }
-    size_t const n = LEN_LIST(ELM_LIST(list, 1));
-    if (n > 65535) {
-      // Then the values in the lookup won't fit into uint16_t
-      ErrorQuit("the lists in the argument must have length at most 65535, "
-                "found %d",
-                (Int) LEN_LIST(list),
-                0L);
+
+    void validate(size_t i) const {
+      if (i >= _elements.size()) {
+        throw std::runtime_error("the argument must be less than "
+                                 + std::to_string(_elements.size())
+                                 + ", found " + std::to_string(i));
+      }
     }
 
-    auto     start_time  = std::chrono::high_resolution_clock::now();
-    auto     last_report = start_time;
-    uint32_t last_count  = 1;
-    bool     report      = libsemigroups::report::should_report();
+    // Returns the position of the join of the i-th and j-th elements.
+    uint32_t join(uf_type& tmp, size_t i, size_t j) const {
+      tmp.join(*_elements[i], *_elements[j]);
+      return position(tmp);
+    }
 
-    std::vector<UF> gens;
-    gens.reserve(LEN_LIST(list));
+    // Returns the position of the meet of the i-th and j-th elements. If the
+    // intersection of the i-th and j-th elements does not belong to the
+    // semilattice, then the meet is the join of the generators contained in
+    // the intersection.
+    uint32_t meet(uf_type& tmp, size_t i, size_t j) const {
+      tmp.meet(*_elements[i], *_elements[j]);
+      auto it = _map.find(&tmp);
+      if (it != _map.end()) {
+        return it->second;
+      }
+      uf_type result(tmp.size());
+      for (auto const& g : _gens) {
+        if (g.is_subset_of(tmp)) {
+          for (size_t x = 0; x < g.size(); ++x) {
+            result.unite(x, g[x]);
+          }
+        }
+      }
+      result.normalize();
+      return position(result);
+    }
 
-    for (size_t i = 1; i <= LEN_LIST(list); ++i) {
-      gens.push_back(to_uf(ELM_LIST(list, i)));
+    // An exception thrown by <f> must not escape the thread it was thrown
+    // in, since that would call std::terminate, and so it is stored and
+    // rethrown once every thread has finished.
+    template <typename Func>
+    Obj table(Obj nr_threads, Func&& f) const {
+      size_t const                    nr_thrds = number_of_threads(nr_threads);
+      size_t const                    N        = _elements.size();
+      std::vector<uint32_t>           table(N * N);
+      std::vector<std::exception_ptr> errors(N);
+      parallel_for(N, nr_thrds, [&](size_t i) {
+        try {
+          uf_type tmp(_gens.front().size());
+          for (size_t j = 0; j < N; ++j) {
+            table[i * N + j] = f(tmp, i, j);
+          }
+        } catch (...) {
+          errors[i] = std::current_exception();
+        }
+      });
+      for (auto const& error : errors) {
+        if (error) {
+          std::rethrow_exception(error);
+        }
+      }
+      Obj result = NEW_PLIST(T_PLIST_TAB_RECT, N);
+      SET_LEN_PLIST(result, N);
+      for (size_t i = 0; i < N; ++i) {
+        Obj row = NEW_PLIST(T_PLIST_CYC, N);
+        SET_LEN_PLIST(row, N);
+        for (size_t j = 0; j < N; ++j) {
+          SET_ELM_PLIST(row, j + 1, INTOBJ_INT(table[i * N + j] + 1));
+        }
+        SET_ELM_PLIST(result, i + 1, row);
+        CHANGED_BAG(result);
+      }
+      return result;
     }
 
-    std::unordered_map<UF*, uint32_t, Hash<UF*>, EqualTo<UF*>> res;
-    Obj latt = NEW_PLIST(T_PLIST_TAB_RECT, 1);
-    AssPlist(latt, 1, NEW_PLIST(T_PLIST_CYC, gens.size()));
+   public:
+    CongruenceLattice() : _cayley_graph(), _elements(), _gens(), _map() {}
 
-    auto one = std::make_unique<UF>(n);
-    auto tmp = std::make_unique<UF>(n);
+    CongruenceLattice(CongruenceLattice const&)            = delete;
+    CongruenceLattice(CongruenceLattice&&)                 = delete;
+    CongruenceLattice& operator=(CongruenceLattice const&) = delete;
+    CongruenceLattice& operator=(CongruenceLattice&&)      = delete;
+    ~CongruenceLattice()                                   = default;
 
-    std::vector<std::unique_ptr<UF>> todo;
-    res.emplace(one.get(), 0);
-    todo.push_back(std::move(one));
+    void init(Obj list) {
+      using libsemigroups::detail::group_digits;
 
-    for (size_t i = 0; i < todo.size(); ++i) {
-      size_t const old_todo_size = todo.size();
+      using std::chrono::duration_cast;
+      using std::chrono::seconds;
 
-      for (size_t j = 0; j < gens.size(); ++j) {
-        auto const& g = gens[j];
-        tmp->join(*todo[i], g);
-        auto it = res.find(tmp.get());
-        if (it == res.end()) {
-          auto cpy = std::make_unique<UF>(*tmp);
-          res.emplace(cpy.get(), todo.size());
-          AssPlist(ELM_PLIST(latt, i + 1), j + 1, INTOBJ_INT(todo.size() + 1));
-          todo.push_back(std::move(cpy));
-        } else {
-          AssPlist(ELM_PLIST(latt, i + 1), j + 1, INTOBJ_INT(it->second + 1));
+      if (LEN_LIST(list) == 0) {
+        ErrorQuit("the argument must be a list of length at least 1, found 0",
+                  0L,
+                  0L);
+      }
+      size_t const n = LEN_LIST(ELM_LIST(list, 1));
+      if (n > 65535) {
+        // Then the values in the lookup won't fit into uint16_t
+        ErrorQuit("the lists in the argument must have length at most 65535, "
+                  "found %d",
+                  (Int) LEN_LIST(list),
+                  0L);
+      }
+
+      auto     start_time  = std::chrono::high_resolution_clock::now();
+      auto     last_report = start_time;
+      uint32_t last_count  = 1;
+      bool     report      = libsemigroups::report::should_report();
+
+      _cayley_graph.clear();
+      _elements.clear();
+      _gens.clear();
+      _map.clear();
+      _gens.reserve(LEN_LIST(list));
+
+      for (size_t i = 1; i <= LEN_LIST(list); ++i) {
+        _gens.push_back(to_uf(ELM_LIST(list, i)));
+        _gens.back().normalize();
+      }
+
+      auto one = std::make_unique<uf_type>(n);
+      auto tmp = std::make_unique<uf_type>(n);
+
+      _map.emplace(one.get(), 0);
+      _elements.push_back(std::move(one));
+
+      for (size_t i = 0; i < _elements.size(); ++i) {
+        for (size_t j = 0; j < _gens.size(); ++j) {
+          auto const& g = _gens[j];
+          tmp->join(*_elements[i], g);
+          auto it = _map.find(tmp.get());
+          if (it == _map.end()) {
+            auto cpy = std::make_unique<uf_type>(*tmp);
+            _map.emplace(cpy.get(), _elements.size());
+            _cayley_graph.push_back(_elements.size());
+            _elements.push_back(std::move(cpy));
+          } else {
+            _cayley_graph.push_back(it->second);
+          }
+        }
+
+        if (report) {
+          auto now = std::chrono::high_resolution_clock::now();
+          if (now - last_report > std::chrono::seconds(1)) {
+            auto total_time = duration_cast<seconds>(now - start_time);
+            auto diff_time  = duration_cast<seconds>(now - last_report);
+            std::cout << "#I  Found " << group_digits(_map.size())
+                      << " congruences in " << total_time.count() << "s ("
+                      << group_digits((_elements.size() - last_count)
+                                      / diff_time.count())
+                      << "/s)!\n";
+            std::swap(now, last_report);
+            last_count = _elements.size();
+          }
         }
       }
-      for (size_t k = old_todo_size; k < todo.size(); ++k) {
-        PushPlist(latt, NEW_PLIST(T_PLIST_CYC, gens.size()));
+    }
+
+    size_t size() const noexcept {
+      return _elements.size();
+    }
+
+    // Returns the right Cayley graph of the semilattice with respect to the
+    // generators, as a GAP list of lists of positive integers.
+    Obj cayley_graph() const {
+      size_t const m      = _gens.size();
+      Obj          result = NEW_PLIST(T_PLIST_TAB_RECT, _elements.size());
+      SET_LEN_PLIST(result, _elements.size());
+      for (size_t i = 0; i < _elements.size(); ++i) {
+        Obj row = NEW_PLIST(T_PLIST_CYC, m);
+        SET_LEN_PLIST(row, m);
+        for (size_t j = 0; j < m; ++j) {
+          SET_ELM_PLIST(row, j + 1, INTOBJ_INT(_cayley_graph[i * m + j] + 1));
+        }
+        SET_ELM_PLIST(result, i + 1, row);
+        CHANGED_BAG(result);
       }
+      return result;
+    }
+
+    size_t join(size_t i, size_t j) const {
+      validate(i);
+      validate(j);
+      uf_type tmp(_gens.front().size());
+      return join(tmp, i, j);
+    }
+
+    size_t meet(size_t i, size_t j) const {
+      validate(i);
+      validate(j);
+      uf_type tmp(_gens.front().size());
+      return meet(tmp, i, j);
+    }
 
+    Obj join_table(Obj nr_threads) const {
+      return table(nr_threads, [this](uf_type& tmp, size_t i, size_t j) {
+        return join(tmp, i, j);
+      });
+    }
+
+    Obj meet_table(Obj nr_threads) const {
+      return table(nr_threads, [this](uf_type& tmp, size_t i, size_t j) {
+        return meet(tmp, i, j);
+      });
+    }
+  };
+
+  ////////////////////////////////////////////////////////////////////////
+  // InverseCongruenceLattice
+  ////////////////////////////////////////////////////////////////////////
+
+  // This class computes the lattice of congruences of a finite inverse
+  // semigroup, where every congruence is stored by its kernel and trace
+  // rather than by its lookup. The lattice is the join semilattice generated
+  // by the congruences generated by the pairs (e, f) of idempotents and
+  // (x, x ^ -1 x) of non-idempotents, since the congruence generated by
+  // (x, y) is the join of those generated by (x ^ -1 x, y ^ -1 y) and
+  // (z, z ^ -1 z) where z = x y ^ -1. The join of two congruences is found by
+  // closing the pairs (x, x ^ -1 x) for x in either kernel, and the pairs in
+  // either trace, under the right and left Cayley graphs; and the meet is
+  // the intersection of the kernels and of the traces.
+  class InverseCongruenceLattice {
+    using uf_type    = UF<uint32_t>;
+    using pair_type  = std::pair<uint32_t, uint32_t>;
+    using stack_type = std::vector<pair_type>;
+    using map_type   = std::unordered_map<KernelTrace*,
+                                        uint32_t,
+                                        libsemigroups::Hash<KernelTrace*>,
+                                        libsemigroups::EqualTo<KernelTrace*>>;
+
+    std::vector<uint32_t> _right;
+    std::vector<uint32_t> _left;
+    std::vector<uint32_t> _right_one;
+    std::vector<uint32_t> _idempotents;
+    size_t                _n;
+    size_t                _m;
+    size_t                _nr_threads;
+
+    std::vector<uint32_t>                     _cayley_graph;
+    std::vector<std::unique_ptr<KernelTrace>> _elements;
+    std::vector<std::unique_ptr<KernelTrace>> _gens;
+    map_type                                  _map;
+
+    // Scratch space for the congruences computed in parallel
+    std::vector<std::unique_ptr<uf_type>>     _chunk_uf;
+    std::vector<stack_type>                   _chunk_stack;
+    std::vector<std::unique_ptr<KernelTrace>> _chunk;
+
+    size_t chunk_size() const noexcept {
+      return 64 * _nr_threads;
+    }
+
+    void validate(size_t i) const {
+      if (i >= _elements.size()) {
+        throw std::runtime_error("the argument must be less than "
+                                 + std::to_string(_elements.size())
+                                 + ", found " + std::to_string(i));
+      }
+    }
+
+    static void unite(uf_type& uf, stack_type& stack, uint32_t x, uint32_t y) {
+      if (uf.find(x) != uf.find(y)) {
+        uf.unite(x, y);
+        stack.emplace_back(x, y);
+      }
+    }
+
+    // Unites the pairs generating the congruence <x> in <uf>.
+    void unite(uf_type& uf, stack_type& stack, KernelTrace const& x) const {
+      for (size_t a = x.kernel.first(); a != Bitset::npos;
+           a = x.kernel.next(a + 1)) {
+        unite(uf, stack, a, _right_one[a]);
+      }
+      for (size_t i = 0; i < _idempotents.size(); ++i) {
+        if (x.trace[i] != i) {
+          unite(uf, stack, _idempotents[i], _idempotents[x.trace[i]]);
+        }
+      }
+    }
+
+    // Sets <result> to the kernel and trace of the congruence <uf>, which
+    // must be normalized.
+    void kernel_trace(uf_type const& uf, KernelTrace& result) const {
+      result.kernel.reset();
+      for (uint32_t x = 0; x < _n; ++x) {
+        if (uf[x] == uf[_right_one[x]]) {
+          result.kernel.set(x);
+        }
+      }
+      // The idempotents are sorted by their classes in <uf>, and then each
+      // is united with the first idempotent in its class.
+      std::vector<pair_type> classes;
+      classes.reserve(_idempotents.size());
+      for (uint32_t i = 0; i < _idempotents.size(); ++i) {
+        classes.emplace_back(uf[_idempotents[i]], i);
+      }
+      std::sort(classes.begin(), classes.end());
+      result.trace.reset();
+      for (size_t i = 1; i < classes.size(); ++i) {
+        if (classes[i].first == classes[i - 1].first) {
+          result.trace.unite(classes[i - 1].second, classes[i].second);
+        }
+      }
+      result.trace.normalize();
+    }
+
+    // Sets _chunk[k] to the join of <x> and <y>, using _chunk_uf[k] and
+    // _chunk_stack[k] as scratch space.
+    void join(size_t k, KernelTrace const& x, KernelTrace const& y) {
+      if (_chunk_uf[k] == nullptr) {
+        _chunk_uf[k] = std::make_unique<uf_type>(_n);
+      } else {
+        _chunk_uf[k]->reset();
+      }
+      if (_chunk[k] == nullptr) {
+        _chunk[k] = std::make_unique<KernelTrace>(_n, _idempotents.size());
+      }
+      unite(*_chunk_uf[k], _chunk_stack[k], x);
+      unite(*_chunk_uf[k], _chunk_stack[k], y);
+      close(*_chunk_uf[k], _right, _left, _m, _chunk_stack[k]);
+      kernel_trace(*_chunk_uf[k], *_chunk[k]);
+    }
+
+    // Finds the congruences generated by the pairs (e, f) of idempotents and
+    // (x, x ^ -1 x) of non-idempotents, and stores the distinct non-trivial
+    // ones in _gens.
+    void init_gens() {
+      std::vector<pair_type> pairs;
+      for (size_t i = 0; i < _idempotents.size(); ++i) {
+        for (size_t j = i + 1; j < _idempotents.size(); ++j) {
+          pairs.emplace_back(_idempotents[i], _idempotents[j]);
+        }
+      }
+      for (uint32_t x = 0; x < _n; ++x) {
+        if (_right_one[x] != x) {
+          pairs.emplace_back(x, _right_one[x]);
+        }
+      }
+
+      map_type map;
+      for (size_t first = 0; first < pairs.size(); first += chunk_size()) {
+        size_t const last = std::min(first + chunk_size(), pairs.size());
+        parallel_for(last - first, _nr_threads, [&](size_t k) {
+          if (_chunk_uf[k] == nullptr) {
+            _chunk_uf[k] = std::make_unique<uf_type>(_n);
+          } else {
+            _chunk_uf[k]->reset();
+          }
+          if (_chunk[k] == nullptr) {
+            _chunk[k] = std::make_unique<KernelTrace>(_n, _idempotents.size());
+          }
+          close(*_chunk_uf[k],
+                _right,
+                _left,
+                _m,
+                pairs[first + k].first,
+                pairs[first + k].second);
+          kernel_trace(*_chunk_uf[k], *_chunk[k]);
+        });
+        for (size_t k = 0; k < last - first; ++k) {
+          if (map.find(_chunk[k].get()) == map.end()) {
+            map.emplace(_chunk[k].get(), _gens.size());
+            _gens.push_back(std::move(_chunk[k]));
+          }
+        }
+      }
+    }
+
+   public:
+    InverseCongruenceLattice()
+        : _right(),
+          _left(),
+          _right_one(),
+          _idempotents(),
+          _n(0),
+          _m(0),
+          _nr_threads(1),
+          _cayley_graph(),
+          _elements(),
+          _gens(),
+          _map(),
+          _chunk_uf(),
+          _chunk_stack(),
+          _chunk() {}
+
+    InverseCongruenceLattice(InverseCongruenceLattice const&) = delete;
+    InverseCongruenceLattice(InverseCongruenceLattice&&)      = delete;
+    InverseCongruenceLattice& operator=(InverseCongruenceLattice const&)
+        = delete;
+    InverseCongruenceLattice& operator=(InverseCongruenceLattice&&) = delete;
+    ~InverseCongruenceLattice()                                     = default;
+
+    // The arguments <right> and <left> must be the right and left Cayley
+    // graphs of an inverse semigroup, and <right_one> must be the list of
+    // the positions of x ^ -1 x for every x.
+    void init(Obj right, Obj left, Obj right_one, Obj nr_threads) {
+      using libsemigroups::detail::group_digits;
+      using std::chrono::duration_cast;
+      using std::chrono::seconds;
+
+      if (!IS_LIST(right) || LEN_LIST(right) == 0
+          || !IS_LIST(ELM_LIST(right, 1))) {
+        throw std::runtime_error("expected a non-empty list of lists");
+      }
+      _n = LEN_LIST(right);
+      _m = LEN_LIST(ELM_LIST(right, 1));
+
+      _right = to_cayley_graph(right, _n, _m);
+      _left  = to_cayley_graph(left, _n, _m);
+      if (!IS_LIST(right_one)
+          || static_cast<size_t>(LEN_LIST(right_one)) != _n) {
+        throw std::runtime_error("expected a list of length "
+                                 + std::to_string(_n));
+      }
+      _right_one.clear();
+      _idempotents.clear();
+      for (size_t x = 1; x <= _n; ++x) {
+        Obj val = ELM_LIST(right_one, x);
+        if (!IS_INTOBJ(val) || INT_INTOBJ(val) < 1
+            || static_cast<size_t>(INT_INTOBJ(val)) > _n) {
+          throw std::runtime_error("expected an integer in the range [1, "
+                                   + std::to_string(_n) + "]");
+        }
+        _right_one.push_back(INT_INTOBJ(val) - 1);
+        if (_right_one.back() == x - 1) {
+          _idempotents.push_back(x - 1);
+        }
+      }
+      if (_idempotents.size() > 65535) {
+        // Then the traces won't fit into uint16_t
+        throw std::runtime_error(
+            "the number of idempotents must be at most 65535, found "
+            + std::to_string(_idempotents.size()));
+      }
+      _nr_threads = number_of_threads(nr_threads);
+
+      _cayley_graph.clear();
+      _elements.clear();
+      _gens.clear();
+      _map.clear();
+      _chunk_uf.clear();
+      _chunk_uf.resize(chunk_size());
+      _chunk_stack.assign(chunk_size(), stack_type());
+      _chunk.clear();
+      _chunk.resize(chunk_size());
+
+      auto     start_time  = std::chrono::high_resolution_clock::now();
+      auto     last_report = start_time;
+      uint32_t last_count  = 1;
+      bool     report      = libsemigroups::report::should_report();
+
+      init_gens();
       if (report) {
-        auto now = std::chrono::high_resolution_clock::now();
-        if (now - last_report > std::chrono::seconds(1)) {
-          auto total_time = duration_cast<seconds>(now - start_time);
-          auto diff_time  = duration_cast<seconds>(now - last_report);
-          std::cout << "#I  Found " << group_digits(res.size())
-                    << " congruences in " << total_time.count() << "s ("
-                    << group_digits((todo.size() - last_count)
-                                    / diff_time.count())
-                    << "/s)!\n";
-          std::swap(now, last_report);
-          last_count = todo.size();
+        auto total_time = duration_cast<seconds>(
+            std::chrono::high_resolution_clock::now() - start_time);
+        std::cout << "#I  Found " << group_digits(_gens.size())
+                  << " generating congruences in " << total_time.count()
+                  << "s\n";
+      }
+
+      auto one = std::make_unique<KernelTrace>(_n, _idempotents.size());
+      for (uint32_t const e : _idempotents) {
+        one->kernel.set(e);
+      }
+      _map.emplace(one.get(), 0);
+      _elements.push_back(std::move(one));
+
+      for (size_t i = 0; i < _elements.size(); ++i) {
+        for (size_t first = 0; first < _gens.size(); first += chunk_size()) {
+          size_t const last = std::min(first + chunk_size(), _gens.size());
+          // The generators contained in the i-th element are not joined
+          std::vector<uint8_t> contained(last - first);
+          parallel_for(last - first, _nr_threads, [&](size_t k) {
+            contained[k] = _gens[first + k]->is_subset_of(*_elements[i]);
+            if (!contained[k]) {
+              join(k, *_elements[i], *_gens[first + k]);
+            }
+          });
+          for (size_t k = 0; k < last - first; ++k) {
+            if (contained[k]) {
+              _cayley_graph.push_back(i);
+              continue;
+            }
+            auto it = _map.find(_chunk[k].get());
+            if (it == _map.end()) {
+              _map.emplace(_chunk[k].get(), _elements.size());
+              _cayley_graph.push_back(_elements.size());
+              _elements.push_back(std::move(_chunk[k]));
+            } else {
+              _cayley_graph.push_back(it->second);
+            }
+          }
+        }
+
+        if (report) {
+          auto now = std::chrono::high_resolution_clock::now();
+          if (now - last_report > std::chrono::seconds(1)) {
+            auto total_time = duration_cast<seconds>(now - start_time);
+            auto diff_time  = duration_cast<seconds>(now - last_report);
+            std::cout << "#I  Found " << group_digits(_map.size())
+                      << " congruences in " << total_time.count() << "s ("
+                      << group_digits((_elements.size() - last_count)
+                                      / diff_time.count())
+                      << "/s)!\n";
+            std::swap(now, last_report);
+            last_count = _elements.size();
+          }
         }
       }
+      // Release the scratch space
+      _chunk_uf.clear();
+      _chunk_stack.clear();
+      _chunk.clear();
     }
-    return latt;
+
+    size_t size() const noexcept {
+      return _elements.size();
+    }
+
+    size_t number_of_generators() const noexcept {
+      return _gens.size();
+    }
+
+    // Returns the right Cayley graph of the semilattice with respect to the
+    // generators, as a GAP list of lists of positive integers.
+    Obj cayley_graph() const {
+      size_t const m      = _gens.size();
+      Obj          result = NEW_PLIST(T_PLIST_TAB_RECT, _elements.size());
+      SET_LEN_PLIST(result, _elements.size());
+      for (size_t i = 0; i < _elements.size(); ++i) {
+        Obj row = NEW_PLIST(T_PLIST_CYC, m);
+        SET_LEN_PLIST(row, m);
+        for (size_t j = 0; j < m; ++j) {
+          SET_ELM_PLIST(row, j + 1, INTOBJ_INT(_cayley_graph[i * m + j] + 1));
+        }
+        SET_ELM_PLIST(result, i + 1, row);
+        CHANGED_BAG(result);
+      }
+      return result;
+    }
+
+    // Returns the positions (plus 1) of the elements in the kernel of the
+    // i-th congruence.
+    Obj kernel(size_t i) const {
+      validate(i);
+      Bitset const& kernel = _elements[i]->kernel;
+      Obj           result = NEW_PLIST(T_PLIST_CYC, kernel.count());
+      for (size_t x = kernel.first(); x != Bitset::npos;
+           x = kernel.next(x + 1)) {
+        PushPlist(result, INTOBJ_INT(x + 1));
+      }
+      return result;
+    }
+
+    // Returns the blocks of the trace of the i-th congruence, as lists of
+    // the positions (plus 1) of idempotents, in the order of their least
+    // elements.
+    Obj trace(size_t i) const {
+      validate(i);
+      auto const&         trace = _elements[i]->trace;
+      std::vector<size_t> block(_idempotents.size(), 0);
+      Obj                 result = NEW_PLIST(T_PLIST, 0);
+      for (size_t j = 0; j < _idempotents.size(); ++j) {
+        Obj list;
+        if (trace[j] == j) {
+          list = NEW_PLIST(T_PLIST_CYC, 0);
+          PushPlist(result, list);
+          block[j] = LEN_PLIST(result);
+        } else {
+          list = ELM_PLIST(result, block[trace[j]]);
+        }
+        PushPlist(list, INTOBJ_INT(_idempotents[j] + 1));
+      }
+      return result;
+    }
+
+    size_t join(size_t i, size_t j) {
+      validate(i);
+      validate(j);
+      _chunk_uf.resize(1);
+      _chunk_stack.resize(1);
+      _chunk.resize(1);
+      join(0, *_elements[i], *_elements[j]);
+      auto it = _map.find(_chunk[0].get());
+      SEMIGROUPS_ASSERT(it != _map.end());
+      return it->second;
+    }
+
+    size_t meet(size_t i, size_t j) const {
+      validate(i);
+      validate(j);
+      KernelTrace tmp(_n, _idempotents.size());
+      tmp.kernel.intersection(_elements[i]->kernel, _elements[j]->kernel);
+      tmp.trace.meet(_elements[i]->trace, _elements[j]->trace);
+      auto it = _map.find(&tmp);
+      if (it == _map.end()) {
+        throw std::runtime_error("the meet does not belong to the lattice");
+      }
+      return it->second;
+    }
+  };
+
+  Obj LATTICE_OF_CONGRUENCES(Obj list) {
+    CongruenceLattice latt;
+    latt.init(list);
+    return latt.cayley_graph();
+  }
+
+  namespace {
+    // This class finds the distinct principal congruences generated by the
+    // pairs added to it in chunks. The congruences generated by the pairs in
+    // a chunk are found in parallel, and are then compared with those
+    // already found in the order that the pairs were given. If any
+    // automorphisms of the semigroup are known, then the images of every new
+    // congruence under these automorphisms are also found (by permuting its
+    // classes rather than by closing the images of its generating pair).
+    class PrincipalCongruenceFinder {
+      using uf_type  = UF<uint32_t>;
+      using map_type = std::unordered_map<uf_type*,
+                                          size_t,
+                                          libsemigroups::Hash<uf_type*>,
+                                          libsemigroups::EqualTo<uf_type*>>;
+      using pair_type = std::pair<uint32_t, uint32_t>;
+
+      std::vector<uint32_t>              _right;
+      std::vector<uint32_t>              _left;
+      size_t                             _n;
+      size_t                             _m;
+      size_t                             _nr_threads;
+      std::vector<std::vector<uint32_t>> _autos;
+
+      std::vector<std::unique_ptr<uf_type>> _chunk;
+      map_type                              _map;
+      std::vector<std::unique_ptr<uf_type>> _found;
+      std::vector<pair_type>                _found_pair;
+      std::vector<size_t>                   _found_index;
+
+      std::chrono::high_resolution_clock::time_point _start_time;
+      std::chrono::high_resolution_clock::time_point _last_report;
+      bool                                           _report;
+
+      void add_found(std::unique_ptr<uf_type> uf, pair_type pair, size_t k) {
+        _map.emplace(uf.get(), _found.size());
+        _found.push_back(std::move(uf));
+        _found_pair.push_back(pair);
+        _found_index.push_back(k);
+      }
+
+      // Adds the images of the congruences in _found from position <first>
+      // onwards under the automorphisms, and so on, until no new congruences
+      // are found.
+      void add_images(size_t first) {
+        if (_autos.empty()) {
+          return;
+        }
+        auto image = std::make_unique<uf_type>(_n);
+        for (size_t i = first; i < _found.size(); ++i) {
+          for (auto const& s : _autos) {
+            uf_type const& uf = *_found[i];
+            image->reset();
+            for (uint32_t x = 0; x < _n; ++x) {
+              image->unite(s[x], s[uf[x]]);
+            }
+            image->normalize();
+            if (_map.find(image.get()) == _map.end()) {
+              pair_type const pair(s[_found_pair[i].first],
+                                   s[_found_pair[i].second]);
+              size_t const    k = _found_index[i];
+              add_found(std::move(image), pair, k);
+              image = std::make_unique<uf_type>(_n);
+            }
+          }
+        }
+      }
+
+     public:
+      PrincipalCongruenceFinder(Obj right, Obj left, Obj nr_threads)
+          : _right(),
+            _left(),
+            _n(0),
+            _m(0),
+            _nr_threads(number_of_threads(nr_threads)),
+            _autos(),
+            _chunk(),
+            _map(),
+            _found(),
+            _found_pair(),
+            _found_index(),
+            _start_time(std::chrono::high_resolution_clock::now()),
+            _last_report(_start_time),
+            _report(libsemigroups::report::should_report()) {
+        Obj graph = (right != Fail ? right : left);
+        if (graph == Fail || !IS_LIST(graph) || LEN_LIST(graph) == 0
+            || !IS_LIST(ELM_LIST(graph, 1))) {
+          throw std::runtime_error("expected a non-empty list of lists");
+        }
+        _n = LEN_LIST(graph);
+        _m = LEN_LIST(ELM_LIST(graph, 1));
+        if (right != Fail) {
+          _right = to_cayley_graph(right, _n, _m);
+        }
+        if (left != Fail) {
+          _left = to_cayley_graph(left, _n, _m);
+        }
+        _chunk.resize(chunk_size());
+      }
+
+      // The argument <autos> must be fail, or a list of permutations of
+      // [1, n] (given by their lists of images) that are automorphisms of
+      // the semigroup.
+      void set_automorphisms(Obj autos) {
+        if (autos == Fail) {
+          return;
+        } else if (!IS_LIST(autos)) {
+          throw std::runtime_error(
+              std::string("expected fail or a list, found ") + TNAM_OBJ(autos));
+        }
+        for (size_t i = 1; i <= static_cast<size_t>(LEN_LIST(autos)); ++i) {
+          Obj                   list = ELM_LIST(autos, i);
+          std::vector<uint32_t> s;
+          std::vector<bool>     seen(_n, false);
+          if (!IS_LIST(list) || static_cast<size_t>(LEN_LIST(list)) != _n) {
+            throw std::runtime_error("expected a list of length "
+                                     + std::to_string(_n));
+          }
+          for (size_t x = 1; x <= _n; ++x) {
+            Obj val = ELM_LIST(list, x);
+            if (!IS_INTOBJ(val) || INT_INTOBJ(val) < 1
+                || static_cast<size_t>(INT_INTOBJ(val)) > _n
+                || seen[INT_INTOBJ(val) - 1]) {
+              throw std::runtime_error("expected a permutation of [1, "
+                                       + std::to_string(_n) + "]");
+            }
+            seen[INT_INTOBJ(val) - 1] = true;
+            s.push_back(INT_INTOBJ(val) - 1);
+          }
+          _autos.push_back(std::move(s));
+        }
+      }
+
+      std::vector<std::vector<uint32_t>> const& automorphisms() const {
+        return _autos;
+      }
+
+      size_t number_of_points() const noexcept {
+        return _n;
+      }
+
+      size_t chunk_size() const noexcept {
+        return 64 * _nr_threads;
+      }
+
+      size_t size() const noexcept {
+        return _found.size();
+      }
+
+      // Finds the congruences generated by the (at most chunk_size()) pairs
+      // <pairs> of distinct points, where index[k] identifies pairs[k].
+      void add(std::vector<pair_type> const& pairs,
+               std::vector<size_t> const&    index) {
+        SEMIGROUPS_ASSERT(pairs.size() <= chunk_size());
+        SEMIGROUPS_ASSERT(pairs.size() == index.size());
+        parallel_for(pairs.size(), _nr_threads, [&](size_t k) {
+          if (_chunk[k] == nullptr) {
+            _chunk[k] = std::make_unique<uf_type>(_n);
+          } else {
+            _chunk[k]->reset();
+          }
+          close(*_chunk[k],
+                _right,
+                _left,
+                _m,
+                pairs[k].first,
+                pairs[k].second);
+        });
+
+        for (size_t k = 0; k < pairs.size(); ++k) {
+          if (_map.find(_chunk[k].get()) == _map.end()) {
+            size_t const first = _found.size();
+            add_found(std::move(_chunk[k]), pairs[k], index[k]);
+            add_images(first);
+          }
+        }
+      }
+
+      void report(std::string const& progress) {
+        using libsemigroups::detail::group_digits;
+        using std::chrono::duration_cast;
+        using std::chrono::seconds;
+        if (_report) {
+          auto now = std::chrono::high_resolution_clock::now();
+          if (now - _last_report > std::chrono::seconds(1)) {
+            auto total_time = duration_cast<seconds>(now - _start_time);
+            std::cout << "#I  " << progress << ": found "
+                      << group_digits(_found.size())
+                      << " principal congruences in " << total_time.count()
+                      << "s\n";
+            std::swap(now, _last_report);
+          }
+        }
+      }
+
+      // Returns a list of triples [id, lookup, nr], one for each
+      // congruence found, where id is the index of its generating pair if
+      // <by_index> is true, and the pair (of points plus 1) if not.
+      Obj to_gap(bool by_index) const {
+        Obj result = NEW_PLIST(T_PLIST, _found.size());
+        SET_LEN_PLIST(result, _found.size());
+        for (size_t k = 0; k < _found.size(); ++k) {
+          Obj lookup = NEW_PLIST(T_PLIST_CYC, _n);
+          SET_LEN_PLIST(lookup, _n);
+          for (size_t i = 0; i < _n; ++i) {
+            SET_ELM_PLIST(lookup, i + 1, INTOBJ_INT((*_found[k])[i] + 1));
+          }
+          Obj id;
+          if (by_index) {
+            id = INTOBJ_INT(_found_index[k]);
+          } else {
+            id = NEW_PLIST(T_PLIST_CYC, 2);
+            SET_LEN_PLIST(id, 2);
+            SET_ELM_PLIST(id, 1, INTOBJ_INT(_found_pair[k].first + 1));
+            SET_ELM_PLIST(id, 2, INTOBJ_INT(_found_pair[k].second + 1));
+          }
+          Obj next = NEW_PLIST(T_PLIST, 3);
+          SET_LEN_PLIST(next, 3);
+          SET_ELM_PLIST(next, 1, id);
+          CHANGED_BAG(next);
+          SET_ELM_PLIST(next, 2, lookup);
+          CHANGED_BAG(next);
+          SET_ELM_PLIST(next, 3, INTOBJ_INT(_found[k]->number_of_blocks()));
+          SET_ELM_PLIST(result, k + 1, next);
+          CHANGED_BAG(result);
+        }
+        return result;
+      }
+    };
+  }  // namespace
+
+  Obj PRINCIPAL_CONGRUENCES(Obj right, Obj left, Obj pairs, Obj nr_threads) {
+    using libsemigroups::detail::group_digits;
+
+    PrincipalCongruenceFinder finder(right, left, nr_threads);
+    if (!IS_LIST(pairs)) {
+      throw std::runtime_error(std::string("expected a list, found ")
+                               + TNAM_OBJ(pairs));
+    }
+    size_t const n          = finder.number_of_points();
+    size_t const total      = LEN_LIST(pairs);
+    size_t const chunk_size = finder.chunk_size();
+
+    std::vector<std::pair<uint32_t, uint32_t>> chunk_pairs;
+    std::vector<size_t>                        chunk_index;
+
+    for (size_t first = 1; first <= total; first += chunk_size) {
+      size_t const last = std::min(first + chunk_size, total + 1);
+      chunk_pairs.clear();
+      chunk_index.clear();
+      for (size_t k = first; k < last; ++k) {
+        Obj pair = ELM_LIST(pairs, k);
+        if (!IS_LIST(pair) || LEN_LIST(pair) != 2) {
+          throw std::runtime_error("expected a list of length 2");
+        }
+        uint32_t x[2];
+        for (size_t i = 0; i < 2; ++i) {
+          Obj val = ELM_LIST(pair, i + 1);
+          if (!IS_INTOBJ(val) || INT_INTOBJ(val) < 1
+              || static_cast<size_t>(INT_INTOBJ(val)) > n) {
+            throw std::runtime_error("expected an integer in the range [1, "
+                                     + std::to_string(n) + "]");
+          }
+          x[i] = INT_INTOBJ(val) - 1;
+        }
+        if (x[0] != x[1]) {
+          chunk_pairs.emplace_back(x[0], x[1]);
+          chunk_index.push_back(k);
+        }
+      }
+      finder.add(chunk_pairs, chunk_index);
+      finder.report("Pair " + group_digits(last - 1) + " of "
+                    + group_digits(total));
+    }
+    return finder.to_gap(true);
+  }
+
+  Obj ALL_PRINCIPAL_CONGRUENCES(Obj right,
+                                Obj left,
+                                Obj autos,
+                                Obj nr_threads) {
+    using libsemigroups::detail::group_digits;
+
+    PrincipalCongruenceFinder finder(right, left, nr_threads);
+    finder.set_automorphisms(autos);
+
+    size_t const n          = finder.number_of_points();
+    size_t const chunk_size = finder.chunk_size();
+    auto const&  s          = finder.automorphisms();
+
+    // If there are automorphisms, then seen.get(x * n + y) is true if the
+    // pair (x, y) with x < y is the image of a pair that was already added,
+    // in which case the congruence it generates was found by add_images.
+    Bitset                                     seen(s.empty() ? 0 : n * n);
+    std::vector<std::pair<uint32_t, uint32_t>> orbit;
+
+    std::vector<std::pair<uint32_t, uint32_t>> chunk_pairs;
+    std::vector<size_t>                        chunk_index;
+
+    size_t nr = 0;
+    for (uint32_t x = 0; x < n; ++x) {
+      for (uint32_t y = x + 1; y < n; ++y) {
+        nr++;
+        if (!s.empty()) {
+          if (seen.get(x * n + y)) {
+            continue;
+          }
+          seen.set(x * n + y);
+          orbit.assign(1, {x, y});
+          for (size_t i = 0; i < orbit.size(); ++i) {
+            for (auto const& t : s) {
+              uint32_t xx = t[orbit[i].first];
+              uint32_t yy = t[orbit[i].second];
+              if (xx > yy) {
+                std::swap(xx, yy);
+              }
+              if (!seen.get(xx * n + yy)) {
+                seen.set(xx * n + yy);
+                orbit.emplace_back(xx, yy);
+              }
+            }
+          }
+        }
+        chunk_pairs.emplace_back(x, y);
+        chunk_index.push_back(nr);
+        if (chunk_pairs.size() == chunk_size) {
+          finder.add(chunk_pairs, chunk_index);
+          chunk_pairs.clear();
+          chunk_index.clear();
+          finder.report("Pair " + group_digits(nr) + " of "
+                        + group_digits(n * (n - 1) / 2));
+        }
+      }
+    }
+    finder.add(chunk_pairs, chunk_index);
+    return finder.to_gap(false);
+  }
+
+  Obj POSET_OF_CONGRUENCES(Obj lookups, Obj nr_threads) {
+    size_t const nr_thrds = number_of_threads(nr_threads);
+
+    if (!IS_LIST(lookups) || LEN_LIST(lookups) == 0) {
+      throw std::runtime_error("expected a non-empty list");
+    }
+    size_t const N = LEN_LIST(lookups);
+    size_t const n = LEN_LIST(ELM_LIST(lookups, 1));
+
+    // lookup[i] is the canonical lookup of the i-th congruence, rep[i][x] is
+    // the least element of the class of x, and nr[i] is the number of
+    // classes.
+    std::vector<std::vector<uint32_t>> lookup(N, std::vector<uint32_t>(n));
+    std::vector<std::vector<uint32_t>> rep(N, std::vector<uint32_t>(n));
+    std::vector<size_t>                nr(N, 0);
+
+    for (size_t i = 0; i < N; ++i) {
+      Obj list = ELM_LIST(lookups, i + 1);
+      if (!IS_LIST(list) || static_cast<size_t>(LEN_LIST(list)) != n) {
+        throw std::runtime_error("expected a list of length "
+                                 + std::to_string(n));
+      }
+      std::vector<uint32_t> first;
+      for (size_t x = 0; x < n; ++x) {
+        Obj val = ELM_LIST(list, x + 1);
+        if (!IS_INTOBJ(val) || INT_INTOBJ(val) < 1
+            || static_cast<size_t>(INT_INTOBJ(val)) > first.size() + 1) {
+          throw std::runtime_error("expected a canonical lookup");
+        }
+        uint32_t const c = INT_INTOBJ(val) - 1;
+        if (c == first.size()) {
+          first.push_back(x);
+        }
+        lookup[i][x] = c;
+        rep[i][x]    = first[c];
+      }
+      nr[i] = first.size();
+    }
+
+    // The congruences are considered in decreasing order of number of
+    // classes, so that the only possible supersets of the congruence in
+    // position k of <order> are in positions [start[k], N) of <order>, where
+    // start[k] is the least position of a congruence with the same number of
+    // classes.
+    std::vector<uint32_t> order(N);
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(), [&nr](uint32_t i, uint32_t j) {
+      return nr[i] > nr[j];
+    });
+    std::vector<size_t> start(N, 0);
+    for (size_t k = 1; k < N; ++k) {
+      start[k] = (nr[order[k]] == nr[order[k - 1]] ? start[k - 1] : k);
+    }
+
+    // up[i] is the set of j such that the i-th congruence is contained in the
+    // j-th congruence.
+    std::vector<Bitset> up(N, Bitset(N));
+    parallel_for(N, nr_thrds, [&](size_t k) {
+      uint32_t const i = order[k];
+      up[i].set(i);
+      for (size_t l = start[k]; l < N; ++l) {
+        uint32_t const j = order[l];
+        if (j == i) {
+          continue;
+        } else if (nr[j] == nr[i]) {
+          if (lookup[j] == lookup[i]) {
+            up[i].set(j);
+          }
+          continue;
+        }
+        // The i-th congruence is contained in the j-th if and only if every
+        // element is related in the j-th congruence to the least element of
+        // its class in the i-th congruence.
+        auto const& lj = lookup[j];
+        auto const& ri = rep[i];
+        size_t      x  = 0;
+        for (; x < n; ++x) {
+          if (lj[x] != lj[ri[x]]) {
+            break;
+          }
+        }
+        if (x == n) {
+          up[i].set(j);
+        }
+      }
+    });
+
+    // The Hasse diagram is only defined if there are no duplicate
+    // congruences.
+    bool duplicates = false;
+    for (size_t i = 0; i < N && !duplicates; ++i) {
+      for (size_t j = up[i].first(); j != Bitset::npos; j = up[i].next(j + 1)) {
+        if (j != i && up[j].get(i)) {
+          duplicates = true;
+          break;
+        }
+      }
+    }
+
+    std::vector<Bitset> hasse;
+    if (!duplicates) {
+      hasse.assign(N, Bitset(N));
+      parallel_for(N, nr_thrds, [&](size_t i) {
+        Bitset strict(up[i]);
+        strict.reset(i);
+        Bitset covers(strict);
+        Bitset above(N);
+        for (size_t j = strict.first(); j != Bitset::npos;
+             j = strict.next(j + 1)) {
+          above = up[j];
+          above.reset(j);
+          covers -= above;
+        }
+        hasse[i] = std::move(covers);
+      });
+    }
+
+    auto bitsets_to_gap = [N](std::vector<Bitset> const& bitsets) {
+      Obj result = NEW_PLIST(T_PLIST, N);
+      SET_LEN_PLIST(result, N);
+      for (size_t i = 0; i < N; ++i) {
+        Obj row = NEW_PLIST(T_PLIST_CYC, bitsets[i].count());
+        for (size_t j = bitsets[i].first(); j != Bitset::npos;
+             j = bitsets[i].next(j + 1)) {
+          PushPlist(row, INTOBJ_INT(j + 1));
+        }
+        if (LEN_PLIST(row) == 0) {
+          RetypeBag(row, T_PLIST_EMPTY);
+        }
+        SET_ELM_PLIST(result, i + 1, row);
+        CHANGED_BAG(result);
+      }
+      return result;
+    };
+
+    Obj result = NEW_PLIST(T_PLIST, 2);
+    SET_LEN_PLIST(result, 2);
+    SET_ELM_PLIST(result, 1, bitsets_to_gap(up));
+    CHANGED_BAG(result);
+    SET_ELM_PLIST(result, 2, duplicates ? Fail : bitsets_to_gap(hasse));
+    CHANGED_BAG(result);
+    return result;
   }
 }  // namespace semigroups
+
+namespace gapbind14 {
+  template <>
+  struct IsGapBind14Type<semigroups::CongruenceLattice> : std::true_type {};
+
+  template <>
+  struct IsGapBind14Type<semigroups::InverseCongruenceLattice>
+      : std::true_type {};
+}  // namespace gapbind14
+
+void init_conglatt(gapbind14::Module& m) {
+  using semigroups::CongruenceLattice;
+  using semigroups::InverseCongruenceLattice;
+
+  gapbind14::class_<CongruenceLattice>("CongruenceLattice")
+      .def(gapbind14::init<>{}, "make")
+      .def("init", &CongruenceLattice::init)
+      .def("size", &CongruenceLattice::size)
+      .def("cayley_graph", &CongruenceLattice::cayley_graph)
+      .def("join",
+           [](CongruenceLattice const& latt, size_t i, size_t j) {
+             return latt.join(i, j);
+           })
+      .def("meet",
+           [](CongruenceLattice const& latt, size_t i, size_t j) {
+             return latt.meet(i, j);
+           })
+      .def("join_table", &CongruenceLattice::join_table)
+      .def("meet_table", &CongruenceLattice::meet_table);
+
+  gapbind14::class_<InverseCongruenceLattice>("InverseCongruenceLattice")
+      .def(gapbind14::init<>{}, "make")
+      .def("init", &InverseCongruenceLattice::init)
+      .def("size", &InverseCongruenceLattice::size)
+      .def("number_of_generators",
+           &InverseCongruenceLattice::number_of_generators)
+      .def("cayley_graph", &InverseCongruenceLattice::cayley_graph)
+      .def("kernel",
+           [](InverseCongruenceLattice const& latt, size_t i) {
+             return latt.kernel(i);
+           })
+      .def("trace",
+           [](InverseCongruenceLattice const& latt, size_t i) {
+             return latt.trace(i);
+           })
+      .def("join",
+           [](InverseCongruenceLattice& latt, size_t i, size_t j) {
+             return latt.join(i, j);
+           })
+      .def("meet",
+           [](InverseCongruenceLattice const& latt, size_t i, size_t j) {
+             return latt.meet(i, j);
+           });
+}
@@ -16,16 +16,54 @@
 // along with this program.  If not, see <https://www.gnu.org/licenses/>.
 //
 
-// This file contains declarations of a function for computing the lattice of
-// congruences of a semigroup from a set of generating congruences.
+// This file contains declarations of functions for computing the lattice of
+// congruences of a semigroup from a set of generating congruences, for
+// computing the principal congruences generated by a list of pairs, and for
+// computing the poset of a list of congruences.
 
 #ifndef SEMIGROUPS_SRC_CONGLATT_HPP_
 #define SEMIGROUPS_SRC_CONGLATT_HPP_
 
 #include "compiled.h"  // for Obj, UInt
 
+// Forward decl
+namespace gapbind14 {
+  class Module;
+}  // namespace gapbind14
+
 namespace semigroups {
   Obj LATTICE_OF_CONGRUENCES(Obj list);
+
+  // Returns a list of triples [k, lookup, nr], one for each distinct
+  // principal congruence generated by a pair in <pairs> (a list of pairs of
+  // positive integers at most the length of the Cayley graphs), where k is
+  // the position in <pairs> of the first pair generating the congruence,
+  // lookup is its lookup table, and nr is its number of classes. The
+  // congruences are right congruences if <left> is fail, left congruences if
+  // <right> is fail, and 2-sided otherwise.
+  Obj PRINCIPAL_CONGRUENCES(Obj right, Obj left, Obj pairs, Obj nr_threads);
+
+  // Returns a list of triples [pair, lookup, nr] as above, one for each
+  // distinct principal congruence generated by a pair of distinct points,
+  // where pair is a pair generating the congruence. The pairs are generated
+  // and closed in batches, and never stored all at once. If <autos> is not
+  // fail, then it must be a list of automorphisms of the semigroup, given as
+  // lists of images of points; the images of every congruence found under
+  // these are then found directly, and no pair in the orbit of a pair
+  // already considered is closed.
+  Obj ALL_PRINCIPAL_CONGRUENCES(Obj right,
+                                Obj left,
+                                Obj autos,
+                                Obj nr_threads);
+
+  // Returns a pair [up, hasse] where <lookups> is a list of the canonical
+  // lookups of congruences over the same semigroup, up[i] is the list of
+  // those j such that the i-th congruence is contained in the j-th, and
+  // hasse[i] is the list of those j that cover i. If there are duplicate
+  // congruences, then hasse is fail.
+  Obj POSET_OF_CONGRUENCES(Obj lookups, Obj nr_threads);
 }
 
+void init_conglatt(gapbind14::Module&);
+
 #endif  // SEMIGROUPS_SRC_CONGLATT_HPP_
@@ -0,0 +1,136 @@
+//
+// Semigroups package for GAP
+// Copyright (C) 2022 James D. Mitchell
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+
+// This file contains the class FreeBandCanonicalForms, which assigns to every
+// element of a free band (in the representation used in gap/fp/freeband.gi) a
+// positive integer, such that two elements are equal if and only if they are
+// assigned the same integer.
+//
+// A free band element x with content C is determined by the 4-tuple:
+//
+//   [first, prefix, last, suffix]
+//
+// where prefix is the longest prefix of x with content of size |C| - 1, first
+// is the letter following it, and suffix and last are defined dually (prefix
+// and suffix are 0 if |C| = 1). Since the tuple of x is uniquely determined by
+// x, the integer assigned to x is the position of the tuple
+//
+//   [first, id(prefix), last, id(suffix)]
+//
+// in a hash table, i.e. the elements are hash-consed. The integer is stored in
+// the component "id" of x, so that it is computed at most once per element,
+// and then comparing, or hashing, two elements is constant time.
+
+#include "freeband.hpp"
+
+#include <array>          // for array
+#include <cstddef>        // for size_t
+#include <type_traits>    // for true_type
+#include <unordered_map>  // for unordered_map
+
+// GAP headers
+#include "compiled.h"  // for Obj, ElmPRec etc
+
+// Semigroups GAP package headers
+#include "pkg.hpp"  // for IsGapBind14Type
+
+// GapBind14 headers
+#include "gapbind14/gapbind14.hpp"  // for class_
+
+namespace semigroups {
+
+  class FreeBandCanonicalForms {
+    using key_type = std::array<size_t, 4>;
+
+    struct KeyHash {
+      size_t operator()(key_type const& key) const noexcept {
+        size_t val = 0;
+        for (auto const& x : key) {
+          val ^= x + 0x9e3779b97f4a7c16 + (val << 6) + (val >> 2);
+        }
+        return val;
+      }
+    };
+
+    std::unordered_map<key_type, size_t, KeyHash> _ids;
+
+    static UInt RNam_id() {
+      static UInt const rnam = RNamName("id");
+      return rnam;
+    }
+
+    static UInt RNam_tuple() {
+      static UInt const rnam = RNamName("tuple");
+      return rnam;
+    }
+
+   public:
+    FreeBandCanonicalForms() : _ids() {}
+
+    // Returns the integer assigned to the free band element x, or 0 if x is
+    // the integer 0, which is used in the tuple of x for an empty prefix or
+    // suffix.
+    size_t id(Obj x) {
+      if (IS_INTOBJ(x)) {
+        return 0;
+      }
+      if (TNUM_OBJ(x) != T_COMOBJ) {
+        ErrorQuit("expected a free band element, found %s",
+                  (Int) TNAM_OBJ(x),
+                  0L);
+      }
+      UInt i;
+      if (FindPRec(x, RNam_id(), &i, 1)) {
+        return INT_INTOBJ(GET_ELM_PREC(x, i));
+      }
+      Obj      tuple = ElmPRec(x, RNam_tuple());
+      key_type key;
+      key[0] = INT_INTOBJ(ELM_LIST(tuple, 1));
+      key[1] = id(ELM_LIST(tuple, 2));
+      key[2] = INT_INTOBJ(ELM_LIST(tuple, 3));
+      key[3] = id(ELM_LIST(tuple, 4));
+      // The argument _ids.size() + 1 is evaluated before the insertion
+      size_t const val = _ids.emplace(key, _ids.size() + 1).first->second;
+      AssPRec(x, RNam_id(), INTOBJ_INT(val));
+      return val;
+    }
+
+    // The number of distinct elements assigned an integer so far.
+    size_t size() const noexcept {
+      return _ids.size();
+    }
+  };
+}  // namespace semigroups
+
+namespace gapbind14 {
+  template <>
+  struct IsGapBind14Type<semigroups::FreeBandCanonicalForms>
+      : std::true_type {};
+}  // namespace gapbind14
+
+void init_freeband(gapbind14::Module& m) {
+  using semigroups::FreeBandCanonicalForms;
+
+  gapbind14::class_<FreeBandCanonicalForms>("FreeBandCanonicalForms")
+      .def(gapbind14::init<>{}, "make")
+      .def("id",
+           [](FreeBandCanonicalForms& cf, Obj x) -> size_t {
+             return cf.id(x);
+           })
+      .def("size", &FreeBandCanonicalForms::size);
+}
@@ -17,10 +17,13 @@
 //
 
 #include <memory>  // for std::shared_ptr
+#include <string>  // for string
+#include <vector>  // for vector
 
 // Semigroups GAP package headers
-#include "to_cpp.hpp"  // for to_cpp
-#include "to_gap.hpp"  // for to_gap
+#include "froidure-pin-file.hpp"  // for write_froidure_pin
+#include "to_cpp.hpp"             // for to_cpp
+#include "to_gap.hpp"             // for to_gap
 
 // libsemigroups headers
 #include "libsemigroups/froidure-pin-base.hpp"  // for FroidurePin
@@ -70,5 +73,12 @@ void init_froidure_pin_base(gapbind14::Module& m) {
       .def("final_letter",
            [](FroidurePin_ S, size_t i) { return S->final_letter(i); })
       .def("prefix", [](FroidurePin_ S, size_t i) { return S->prefix(i); })
-      .def("suffix", [](FroidurePin_ S, size_t i) { return S->suffix(i); });
+      .def("suffix", [](FroidurePin_ S, size_t i) { return S->suffix(i); })
+      .def("write", [](FroidurePin_ S, std::string filename) {
+        std::vector<bool> is_idempotent(S->size());
+        for (size_t i = 0; i < is_idempotent.size(); ++i) {
+          is_idempotent[i] = (S->product_by_reduction(i, i) == i);
+        }
+        semigroups::write_froidure_pin(*S, filename, is_idempotent);
+      });
 }
@@ -0,0 +1,478 @@
+//
+// Semigroups package for GAP
+// Copyright (C) 2022 James D. Mitchell
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+
+// This file contains functions for writing the state of a fully enumerated
+// libsemigroups::FroidurePin to a binary file, and a class FroidurePinFile for
+// reading such a file using mmap, see froidure-pin-file.hpp for a description
+// of the format.
+
+#include "froidure-pin-file.hpp"
+
+#include <fcntl.h>     // for open, O_RDONLY
+#include <sys/mman.h>  // for mmap, munmap
+#include <sys/stat.h>  // for fstat
+#include <unistd.h>    // for close
+
+#include <cstddef>      // for size_t
+#include <cstdint>      // for uint32_t, uint64_t, uint8_t
+#include <cstring>      // for memcpy
+#include <fstream>      // for ofstream
+#include <stdexcept>    // for runtime_error
+#include <string>       // for string
+#include <type_traits>  // for true_type
+#include <vector>       // for vector
+
+// GAP headers
+#include "compiled.h"  // for Obj
+
+// Semigroups GAP package headers
+#include "pkg.hpp"  // for IsGapBind14Type
+
+// GapBind14 headers
+#include "gapbind14/gapbind14.hpp"  // for class_
+
+// libsemigroups headers
+#include "libsemigroups/constants.hpp"          // for UNDEFINED
+#include "libsemigroups/froidure-pin-base.hpp"  // for FroidurePinBase
+#include "libsemigroups/types.hpp"              // for word_type
+
+namespace semigroups {
+
+  namespace {
+    // "SGPFPIN" followed by a 0 byte, as a little endian integer
+    constexpr uint64_t MAGIC      = 0x004e495046504753;
+    constexpr uint64_t VERSION    = 1;
+    constexpr uint64_t ENDIAN_MARK = 0x0102030405060708;
+
+    constexpr size_t HEADER_LENGTH = 8;
+
+    enum header_index : size_t {
+      HEADER_MAGIC                = 0,
+      HEADER_VERSION              = 1,
+      HEADER_ENDIAN_MARK          = 2,
+      HEADER_NUMBER_OF_GENERATORS = 3,
+      HEADER_SIZE                 = 4,
+      HEADER_NUMBER_OF_RULES      = 5,
+      HEADER_RULES_LENGTH         = 6,
+      HEADER_RESERVED             = 7
+    };
+
+    constexpr uint32_t UNDEFINED_32 = static_cast<uint32_t>(-1);
+
+    // Writes the values v to the file, in batches to avoid allocating the
+    // entire section.
+    class SectionWriter {
+      std::ofstream&        _file;
+      std::vector<uint32_t> _buf;
+
+     public:
+      explicit SectionWriter(std::ofstream& file) : _file(file), _buf() {
+        _buf.reserve(1 << 16);
+      }
+
+      ~SectionWriter() {
+        flush();
+      }
+
+      void push_back(size_t val) {
+        _buf.push_back(val == libsemigroups::UNDEFINED
+                           ? UNDEFINED_32
+                           : static_cast<uint32_t>(val));
+        if (_buf.size() == _buf.capacity()) {
+          flush();
+        }
+      }
+
+      void flush() {
+        _file.write(reinterpret_cast<char const*>(_buf.data()),
+                    _buf.size() * sizeof(uint32_t));
+        _buf.clear();
+      }
+    };
+  }  // namespace
+
+  void write_froidure_pin(libsemigroups::FroidurePinBase& S,
+                          std::string const&               filename,
+                          std::vector<bool> const&         is_idempotent) {
+    using libsemigroups::word_type;
+
+    size_t const n = S.size();
+    size_t const m = S.number_of_generators();
+    if (n >= UNDEFINED_32) {
+      throw std::runtime_error("the semigroup is too large to write to a file");
+    } else if (is_idempotent.size() != n) {
+      throw std::runtime_error("the number of idempotent flags is incorrect");
+    }
+
+    uint64_t rules_length = 0;
+    for (auto it = S.cbegin_rules(); it != S.cend_rules(); ++it) {
+      rules_length += it->first.size() + it->second.size() + 2;
+    }
+
+    std::ofstream file(filename, std::ios::out | std::ios::binary);
+    if (!file) {
+      throw std::runtime_error("cannot open the file for writing");
+    }
+
+    uint64_t header[HEADER_LENGTH]      = {0};
+    header[HEADER_MAGIC]                = MAGIC;
+    header[HEADER_VERSION]              = VERSION;
+    header[HEADER_ENDIAN_MARK]          = ENDIAN_MARK;
+    header[HEADER_NUMBER_OF_GENERATORS] = m;
+    header[HEADER_SIZE]                 = n;
+    header[HEADER_NUMBER_OF_RULES]      = S.number_of_rules();
+    header[HEADER_RULES_LENGTH]         = rules_length;
+    file.write(reinterpret_cast<char const*>(header), sizeof(header));
+
+    {
+      SectionWriter out(file);
+      auto const&   right = S.right_cayley_graph();
+      for (size_t i = 0; i < n; ++i) {
+        for (size_t a = 0; a < m; ++a) {
+          out.push_back(right.get(i, a));
+        }
+      }
+      auto const& left = S.left_cayley_graph();
+      for (size_t i = 0; i < n; ++i) {
+        for (size_t a = 0; a < m; ++a) {
+          out.push_back(left.get(i, a));
+        }
+      }
+      for (size_t i = 0; i < n; ++i) {
+        out.push_back(S.prefix(i));
+      }
+      for (size_t i = 0; i < n; ++i) {
+        out.push_back(S.suffix(i));
+      }
+      for (size_t i = 0; i < n; ++i) {
+        out.push_back(S.first_letter(i));
+      }
+      for (size_t i = 0; i < n; ++i) {
+        out.push_back(S.final_letter(i));
+      }
+      for (size_t i = 0; i < n; ++i) {
+        out.push_back(S.length_const(i));
+      }
+      for (auto it = S.cbegin_rules(); it != S.cend_rules(); ++it) {
+        for (word_type const* w : {&it->first, &it->second}) {
+          out.push_back(w->size());
+          for (auto const& a : *w) {
+            out.push_back(a);
+          }
+        }
+      }
+    }
+
+    std::vector<uint8_t> idempotents(is_idempotent.cbegin(),
+                                     is_idempotent.cend());
+    file.write(reinterpret_cast<char const*>(idempotents.data()), n);
+    if (!file) {
+      throw std::runtime_error("error writing to the file");
+    }
+  }
+
+  // A FroidurePinFile is a read only view of a file written by
+  // write_froidure_pin. The file is memory mapped, and so opening even very
+  // large files is fast, and only the parts of the file that are used are
+  // actually read. The member functions returning a single position or letter
+  // use 0-based indexing, like those of libsemigroups::FroidurePin, but those
+  // returning GAP lists use 1-based indexing, so that they can be used
+  // directly in GAP.
+  class FroidurePinFile {
+    void*           _addr;
+    size_t          _file_size;
+    uint64_t const* _header;
+    uint32_t const* _right;
+    uint32_t const* _left;
+    uint32_t const* _prefix;
+    uint32_t const* _suffix;
+    uint32_t const* _first;
+    uint32_t const* _final;
+    uint32_t const* _length;
+    uint32_t const* _rules;
+    uint8_t const*  _idempotents;
+
+    void validate_position(size_t i) const {
+      if (_addr == nullptr) {
+        throw std::runtime_error("no file has been read");
+      } else if (i >= size()) {
+        throw std::runtime_error("the argument must be less than "
+                                 + std::to_string(size()) + ", found "
+                                 + std::to_string(i));
+      }
+    }
+
+    Obj cayley_graph_to_gap(uint32_t const* graph) const {
+      size_t const n      = size();
+      size_t const m      = number_of_generators();
+      Obj          result = NEW_PLIST(T_PLIST_TAB_RECT, n);
+      SET_LEN_PLIST(result, n);
+      for (size_t i = 0; i < n; ++i) {
+        Obj next = NEW_PLIST(T_PLIST_CYC, m);
+        SET_LEN_PLIST(next, m);
+        for (size_t a = 0; a < m; ++a) {
+          if (graph[i * m + a] >= n) {
+            throw std::runtime_error("the file is corrupt");
+          }
+          SET_ELM_PLIST(next, a + 1, INTOBJ_INT(graph[i * m + a] + 1));
+        }
+        SET_ELM_PLIST(result, i + 1, next);
+        CHANGED_BAG(result);
+      }
+      return result;
+    }
+
+    void reset() {
+      if (_addr != nullptr) {
+        munmap(_addr, _file_size);
+      }
+      _addr        = nullptr;
+      _file_size   = 0;
+      _header      = nullptr;
+      _right       = nullptr;
+      _left        = nullptr;
+      _prefix      = nullptr;
+      _suffix      = nullptr;
+      _first       = nullptr;
+      _final       = nullptr;
+      _length      = nullptr;
+      _rules       = nullptr;
+      _idempotents = nullptr;
+    }
+
+   public:
+    FroidurePinFile()
+        : _addr(nullptr),
+          _file_size(0),
+          _header(nullptr),
+          _right(nullptr),
+          _left(nullptr),
+          _prefix(nullptr),
+          _suffix(nullptr),
+          _first(nullptr),
+          _final(nullptr),
+          _length(nullptr),
+          _rules(nullptr),
+          _idempotents(nullptr) {}
+
+    FroidurePinFile(FroidurePinFile const&)            = delete;
+    FroidurePinFile(FroidurePinFile&&)                 = delete;
+    FroidurePinFile& operator=(FroidurePinFile const&) = delete;
+    FroidurePinFile& operator=(FroidurePinFile&&)      = delete;
+
+    ~FroidurePinFile() {
+      reset();
+    }
+
+    void init(std::string const& filename) {
+      reset();
+      int fd = open(filename.c_str(), O_RDONLY);
+      if (fd == -1) {
+        throw std::runtime_error("cannot open the file for reading");
+      }
+      struct stat st;
+      if (fstat(fd, &st) == -1
+          || static_cast<size_t>(st.st_size)
+                 < HEADER_LENGTH * sizeof(uint64_t)) {
+        close(fd);
+        throw std::runtime_error("the file is not a FroidurePin file");
+      }
+      void* addr = mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+      close(fd);
+      if (addr == MAP_FAILED) {
+        throw std::runtime_error("cannot map the file");
+      }
+      _addr      = addr;
+      _file_size = st.st_size;
+      _header    = static_cast<uint64_t const*>(_addr);
+
+      if (_header[HEADER_MAGIC] != MAGIC) {
+        reset();
+        throw std::runtime_error("the file is not a FroidurePin file");
+      } else if (_header[HEADER_ENDIAN_MARK] != ENDIAN_MARK) {
+        reset();
+        throw std::runtime_error("the file was written on a machine with a "
+                                 "different byte order");
+      } else if (_header[HEADER_VERSION] != VERSION) {
+        uint64_t version = _header[HEADER_VERSION];
+        reset();
+        throw std::runtime_error("the file has version "
+                                 + std::to_string(version) + ", expected "
+                                 + std::to_string(VERSION));
+      }
+
+      uint64_t const n   = _header[HEADER_SIZE];
+      uint64_t const m   = _header[HEADER_NUMBER_OF_GENERATORS];
+      uint64_t const len = _header[HEADER_RULES_LENGTH];
+      if (n >= UNDEFINED_32 || m >= UNDEFINED_32
+          || _file_size != sizeof(uint64_t) * HEADER_LENGTH
+                               + sizeof(uint32_t) * (2 * n * m + 5 * n + len)
+                               + n) {
+        reset();
+        throw std::runtime_error("the file is corrupt");
+      }
+
+      _right       = reinterpret_cast<uint32_t const*>(_header + HEADER_LENGTH);
+      _left        = _right + n * m;
+      _prefix      = _left + n * m;
+      _suffix      = _prefix + n;
+      _first       = _suffix + n;
+      _final       = _first + n;
+      _length      = _final + n;
+      _rules       = _length + n;
+      _idempotents = reinterpret_cast<uint8_t const*>(_rules + len);
+    }
+
+    size_t number_of_generators() const noexcept {
+      return _addr == nullptr ? 0 : _header[HEADER_NUMBER_OF_GENERATORS];
+    }
+
+    size_t size() const noexcept {
+      return _addr == nullptr ? 0 : _header[HEADER_SIZE];
+    }
+
+    size_t number_of_rules() const noexcept {
+      return _addr == nullptr ? 0 : _header[HEADER_NUMBER_OF_RULES];
+    }
+
+    size_t prefix(size_t i) const {
+      validate_position(i);
+      return _prefix[i] == UNDEFINED_32 ? libsemigroups::UNDEFINED
+                                        : _prefix[i];
+    }
+
+    size_t suffix(size_t i) const {
+      validate_position(i);
+      return _suffix[i] == UNDEFINED_32 ? libsemigroups::UNDEFINED
+                                        : _suffix[i];
+    }
+
+    size_t first_letter(size_t i) const {
+      validate_position(i);
+      return _first[i];
+    }
+
+    size_t final_letter(size_t i) const {
+      validate_position(i);
+      return _final[i];
+    }
+
+    size_t length(size_t i) const {
+      validate_position(i);
+      return _length[i];
+    }
+
+    bool is_idempotent(size_t i) const {
+      validate_position(i);
+      return _idempotents[i] != 0;
+    }
+
+    libsemigroups::word_type factorisation(size_t i) const {
+      validate_position(i);
+      libsemigroups::word_type result(_length[i], 0);
+      for (size_t j = result.size(); j > 0; --j) {
+        if (i >= size() || _final[i] >= number_of_generators()) {
+          throw std::runtime_error("the file is corrupt");
+        }
+        result[j - 1] = _final[i];
+        i             = _prefix[i];
+      }
+      return result;
+    }
+
+    Obj right_cayley_graph() const {
+      return cayley_graph_to_gap(_right);
+    }
+
+    Obj left_cayley_graph() const {
+      return cayley_graph_to_gap(_left);
+    }
+
+    // Returns the positions of the idempotents
+    Obj idempotents() const {
+      Obj result = NEW_PLIST(T_PLIST_CYC, 0);
+      for (size_t i = 0; i < size(); ++i) {
+        if (_idempotents[i] != 0) {
+          PushPlist(result, INTOBJ_INT(i + 1));
+        }
+      }
+      return result;
+    }
+
+    // Returns the rules as a list of pairs of words in the generators. The
+    // lengths and letters are checked against the header, since the rules
+    // section is only known to have the right total length.
+    Obj rules() const {
+      if (_addr == nullptr) {
+        throw std::runtime_error("no file has been read");
+      }
+      Obj             result = NEW_PLIST(T_PLIST, number_of_rules());
+      uint32_t const* ptr    = _rules;
+      uint32_t const* last   = _rules + _header[HEADER_RULES_LENGTH];
+      size_t const    m      = number_of_generators();
+      for (size_t i = 0; i < number_of_rules(); ++i) {
+        Obj pair = NEW_PLIST(T_PLIST, 2);
+        for (size_t j = 0; j < 2; ++j) {
+          if (ptr == last || *ptr > static_cast<size_t>(last - ptr - 1)) {
+            throw std::runtime_error("the file is corrupt");
+          }
+          size_t const len  = *ptr++;
+          Obj          word = NEW_PLIST(T_PLIST_CYC, len);
+          SET_LEN_PLIST(word, len);
+          for (size_t k = 0; k < len; ++k) {
+            if (*ptr >= m) {
+              throw std::runtime_error("the file is corrupt");
+            }
+            SET_ELM_PLIST(word, k + 1, INTOBJ_INT(*ptr++ + 1));
+          }
+          PushPlist(pair, word);
+        }
+        PushPlist(result, pair);
+      }
+      return result;
+    }
+  };
+}  // namespace semigroups
+
+namespace gapbind14 {
+  template <>
+  struct IsGapBind14Type<semigroups::FroidurePinFile> : std::true_type {};
+}  // namespace gapbind14
+
+void init_froidure_pin_file(gapbind14::Module& m) {
+  using semigroups::FroidurePinFile;
+
+  gapbind14::class_<FroidurePinFile>("FroidurePinFile")
+      .def(gapbind14::init<>{}, "make")
+      .def("init",
+           [](FroidurePinFile& f, std::string filename) { f.init(filename); })
+      .def("number_of_generators", &FroidurePinFile::number_of_generators)
+      .def("size", &FroidurePinFile::size)
+      .def("number_of_rules", &FroidurePinFile::number_of_rules)
+      .def("prefix", &FroidurePinFile::prefix)
+      .def("suffix", &FroidurePinFile::suffix)
+      .def("first_letter", &FroidurePinFile::first_letter)
+      .def("final_letter", &FroidurePinFile::final_letter)
+      .def("length", &FroidurePinFile::length)
+      .def("is_idempotent", &FroidurePinFile::is_idempotent)
+      .def("factorisation", &FroidurePinFile::factorisation)
+      .def("right_cayley_graph", &FroidurePinFile::right_cayley_graph)
+      .def("left_cayley_graph", &FroidurePinFile::left_cayley_graph)
+      .def("idempotents", &FroidurePinFile::idempotents)
+      .def("rules", &FroidurePinFile::rules);
+}
@@ -0,0 +1,74 @@
+//
+// Semigroups package for GAP
+// Copyright (C) 2022 James D. Mitchell
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+
+// This file contains declarations of functions for writing the state of a
+// fully enumerated libsemigroups::FroidurePin to a binary file, and reading it
+// back using a memory mapped file.
+//
+// The format of the file (version 1) is as follows, all integers are stored
+// in the byte order of the machine that wrote the file, which is recorded in
+// the header, and is checked when the file is read:
+//
+//   header, consisting of 8 uint64_t values:
+//     magic number, version, byte order mark, number of generators (m),
+//     size (n), number of rules, number of uint32_t values in the rules
+//     section, reserved (0)
+//   right Cayley graph: n * m uint32_t values
+//   left Cayley graph:  n * m uint32_t values
+//   prefixes:           n uint32_t values (UNDEFINED for the generators)
+//   suffixes:           n uint32_t values (UNDEFINED for the generators)
+//   first letters:      n uint32_t values
+//   final letters:      n uint32_t values
+//   lengths:            n uint32_t values
+//   rules:              for each rule, the length of the left hand side, its
+//                       letters, then the length of the right hand side, and
+//                       its letters, all as uint32_t values
+//   idempotents:        n uint8_t values, 1 for an idempotent, 0 otherwise
+//
+// The elements themselves are not stored, since the file is intended to be
+// read into a semigroup with the same generators, and the position of every
+// element can then be recovered from its factorisation.
+
+#ifndef SEMIGROUPS_SRC_FROIDURE_PIN_FILE_HPP_
+#define SEMIGROUPS_SRC_FROIDURE_PIN_FILE_HPP_
+
+#include <cstddef>  // for size_t
+#include <string>   // for string
+#include <vector>   // for vector
+
+// libsemigroups headers
+#include "libsemigroups/froidure-pin-base.hpp"  // for FroidurePinBase
+
+// Forward decl
+namespace gapbind14 {
+  class Module;
+}  // namespace gapbind14
+
+namespace semigroups {
+
+  // Writes the state of S, which is fully enumerated first, to the file
+  // filename. The i-th entry of is_idempotent must be true if and only if the
+  // element in position i of S is an idempotent.
+  void write_froidure_pin(libsemigroups::FroidurePinBase& S,
+                          std::string const&               filename,
+                          std::vector<bool> const&         is_idempotent);
+}  // namespace semigroups
+
+void init_froidure_pin_file(gapbind14::Module&);
+
+#endif  // SEMIGROUPS_SRC_FROIDURE_PIN_FILE_HPP_
@@ -26,6 +26,9 @@
 #include <utility>      // for pair
 #include <vector>       // for vector
 
+// Semigroups GAP package headers
+#include "froidure-pin-file.hpp"  // for write_froidure_pin
+
 // GapBind14 headers
 #include "gapbind14/gapbind14.hpp"  // for Module etc
 
@@ -98,7 +101,14 @@ void bind_froidure_pin(gapbind14::Module& m, std::string name) {
       .def("first_letter", &FroidurePin_::first_letter)
       .def("final_letter", &FroidurePin_::final_letter)
       .def("prefix", &FroidurePin_::prefix)
-      .def("suffix", &FroidurePin_::suffix);
+      .def("suffix", &FroidurePin_::suffix)
+      .def("write", [](FroidurePin_& S, std::string filename) {
+        std::vector<bool> is_idempotent(S.size());
+        for (size_t i = 0; i < is_idempotent.size(); ++i) {
+          is_idempotent[i] = S.is_idempotent(i);
+        }
+        semigroups::write_froidure_pin(S, filename, is_idempotent);
+      });
 }
 
 namespace semigroups {
@@ -0,0 +1,577 @@
+//
+// Semigroups package for GAP
+// Copyright (C) 2025 James D. Mitchell
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+
+// This file contains functions for writing collections of transformations,
+// partial perms, and bipartitions to a binary file, and a class
+// GeneratorsFile for reading such a file using mmap, see generators-file.hpp
+// for a description of the format.
+
+#include "generators-file.hpp"
+
+#include <fcntl.h>     // for open, O_RDONLY
+#include <sys/mman.h>  // for mmap, munmap
+#include <sys/stat.h>  // for fstat
+#include <unistd.h>    // for close
+
+#include <algorithm>    // for max
+#include <cstddef>      // for size_t
+#include <cstdint>      // for uint16_t, uint32_t, uint64_t
+#include <fstream>      // for fstream, ifstream
+#include <stdexcept>    // for runtime_error
+#include <string>       // for string, to_string
+#include <type_traits>  // for true_type
+#include <vector>       // for vector
+
+// GAP headers
+#include "compiled.h"  // for Obj, NEW_TRANS, NEW_PPERM2 etc
+
+// Semigroups GAP package headers
+#include "bipart.hpp"  // for bipart_get_cpp, bipart_new_obj
+#include "pkg.hpp"     // for IsGapBind14Type, T_BIPART
+
+// GapBind14 headers
+#include "gapbind14/gapbind14.hpp"  // for class_
+
+// libsemigroups headers
+#include "libsemigroups/bipart.hpp"  // for Bipartition
+
+namespace semigroups {
+
+  namespace {
+    // "SGPGENS" followed by a 0 byte, as a little endian integer
+    constexpr uint64_t MAGIC   = 0x00534e4547504753;
+    constexpr uint64_t VERSION = 1;
+
+    constexpr size_t HEADER_LENGTH        = 8;
+    constexpr size_t RECORD_HEADER_LENGTH = 4;
+
+    enum header_index : size_t {
+      HEADER_MAGIC             = 0,
+      HEADER_VERSION           = 1,
+      HEADER_NUMBER_OF_RECORDS = 2,
+      HEADER_INDEX             = 3
+    };
+
+    enum record_header_index : size_t {
+      RECORD_TYPE   = 0,
+      RECORD_WIDTH  = 1,
+      RECORD_LENGTH = 2
+    };
+
+    enum element_type : uint32_t {
+      TRANSFORMATION = 0,
+      PARTIAL_PERM   = 1,
+      BIPARTITION    = 2
+    };
+
+    ////////////////////////////////////////////////////////////////////////
+    // Little endian values
+    ////////////////////////////////////////////////////////////////////////
+
+    // The compiler turns these into a single load or store on little endian
+    // machines.
+    template <typename T>
+    T load(unsigned char const* ptr) noexcept {
+      T result = 0;
+      for (size_t i = 0; i < sizeof(T); ++i) {
+        result |= static_cast<T>(ptr[i]) << (8 * i);
+      }
+      return result;
+    }
+
+    template <typename T>
+    void store(std::vector<unsigned char>& buf, T val) {
+      for (size_t i = 0; i < sizeof(T); ++i) {
+        buf.push_back(static_cast<unsigned char>(val >> (8 * i)));
+      }
+    }
+
+    // Throws if the HEADER_LENGTH uint64_t values at <header> are not the
+    // header of a file of <file_size> bytes in the format described in
+    // generators-file.hpp.
+    void validate_header(unsigned char const* header, uint64_t file_size) {
+      uint64_t const magic   = load<uint64_t>(header + 8 * HEADER_MAGIC);
+      uint64_t const version = load<uint64_t>(header + 8 * HEADER_VERSION);
+      uint64_t const n = load<uint64_t>(header + 8 * HEADER_NUMBER_OF_RECORDS);
+      uint64_t const index = load<uint64_t>(header + 8 * HEADER_INDEX);
+      if (magic != MAGIC) {
+        throw std::runtime_error("the file is not a generators file");
+      } else if (version != VERSION) {
+        throw std::runtime_error("the file has version "
+                                 + std::to_string(version) + ", expected "
+                                 + std::to_string(VERSION));
+      } else if (index < HEADER_LENGTH * sizeof(uint64_t) || index > file_size
+                 || (file_size - index) / sizeof(uint64_t) != n
+                 || (file_size - index) % sizeof(uint64_t) != 0) {
+        throw std::runtime_error("the file is corrupt");
+      }
+    }
+
+    ////////////////////////////////////////////////////////////////////////
+    // Writing
+    ////////////////////////////////////////////////////////////////////////
+
+    uint32_t type_of_element(Obj x) {
+      if (IS_TRANS(x)) {
+        return TRANSFORMATION;
+      } else if (IS_PPERM(x)) {
+        return PARTIAL_PERM;
+      } else if (TNUM_OBJ(x) == T_BIPART) {
+        return BIPARTITION;
+      }
+      throw std::runtime_error(
+          "the 2nd argument must consist of lists of transformations, partial "
+          "perms, or bipartitions, found "
+          + std::string(TNAM_OBJ(x)));
+    }
+
+    template <typename T>
+    void push_transformation(T const* ptr,
+                             size_t                 deg,
+                             std::vector<uint32_t>& degrees,
+                             std::vector<uint32_t>& values) {
+      // Only the images up to the last point moved are written
+      while (deg > 0 && ptr[deg - 1] == deg - 1) {
+        deg--;
+      }
+      degrees.push_back(deg);
+      values.insert(values.end(), ptr, ptr + deg);
+    }
+
+    template <typename T>
+    void push_partial_perm(T const* ptr,
+                           size_t                 deg,
+                           std::vector<uint32_t>& degrees,
+                           std::vector<uint32_t>& values) {
+      degrees.push_back(deg);
+      values.insert(values.end(), ptr, ptr + deg);
+    }
+
+    // Appends the record for the GAP list <coll> to <buf>.
+    void encode_record(Obj coll, std::vector<unsigned char>& buf) {
+      if (!IS_LIST(coll)) {
+        throw std::runtime_error("the 2nd argument must consist of lists");
+      }
+      size_t const          k    = LEN_LIST(coll);
+      uint32_t              type = TRANSFORMATION;
+      std::vector<uint32_t> degrees;
+      std::vector<uint32_t> values;
+      degrees.reserve(k);
+
+      for (size_t i = 1; i <= k; ++i) {
+        Obj x = ELM0_LIST(coll, i);
+        if (x == 0) {
+          throw std::runtime_error("the 2nd argument must consist of dense "
+                                   "lists");
+        }
+        uint32_t const t = type_of_element(x);
+        if (i == 1) {
+          type = t;
+        } else if (t != type) {
+          throw std::runtime_error(
+              "the 2nd argument must consist of lists of transformations, "
+              "partial perms, or bipartitions, but not a mixture of these");
+        }
+        switch (t) {
+          case TRANSFORMATION:
+            if (TNUM_OBJ(x) == T_TRANS2) {
+              push_transformation(
+                  CONST_ADDR_TRANS2(x), DEG_TRANS(x), degrees, values);
+            } else {
+              push_transformation(
+                  CONST_ADDR_TRANS4(x), DEG_TRANS(x), degrees, values);
+            }
+            break;
+          case PARTIAL_PERM:
+            if (TNUM_OBJ(x) == T_PPERM2) {
+              push_partial_perm(ADDR_PPERM2(x), DEG_PPERM(x), degrees, values);
+            } else {
+              push_partial_perm(ADDR_PPERM4(x), DEG_PPERM(x), degrees, values);
+            }
+            break;
+          default: {
+            auto const*  xx  = bipart_get_cpp(x);
+            size_t const deg = xx->degree();
+            degrees.push_back(deg);
+            for (size_t j = 0; j < 2 * deg; ++j) {
+              values.push_back(xx->at(j));
+            }
+          }
+        }
+      }
+
+      uint32_t max = 0;
+      for (auto const& val : values) {
+        max = std::max(max, val);
+      }
+      uint32_t const width = (max <= UINT16_MAX ? 2 : 4);
+
+      store<uint32_t>(buf, type);
+      store<uint32_t>(buf, width);
+      store<uint32_t>(buf, k);
+      store<uint32_t>(buf, 0);
+      for (auto const& deg : degrees) {
+        store<uint32_t>(buf, deg);
+      }
+      if (width == 2) {
+        for (auto const& val : values) {
+          store<uint16_t>(buf, val);
+        }
+      } else {
+        for (auto const& val : values) {
+          store<uint32_t>(buf, val);
+        }
+      }
+      while (buf.size() % sizeof(uint64_t) != 0) {
+        buf.push_back(0);
+      }
+    }
+
+    ////////////////////////////////////////////////////////////////////////
+    // Reading
+    ////////////////////////////////////////////////////////////////////////
+
+    [[noreturn]] void corrupt() {
+      throw std::runtime_error("the file is corrupt");
+    }
+
+    template <typename T, typename S>
+    void fill_transformation(S* ptr, unsigned char const* src, size_t deg) {
+      for (size_t i = 0; i < deg; ++i) {
+        T const val = load<T>(src + i * sizeof(T));
+        if (val >= deg) {
+          corrupt();
+        }
+        ptr[i] = val;
+      }
+    }
+
+    template <typename T>
+    Obj new_transformation(unsigned char const* src, size_t deg) {
+      Obj x = NEW_TRANS(deg);
+      if (TNUM_OBJ(x) == T_TRANS2) {
+        fill_transformation<T>(ADDR_TRANS2(x), src, deg);
+      } else {
+        fill_transformation<T>(ADDR_TRANS4(x), src, deg);
+      }
+      return x;
+    }
+
+    template <typename T, typename S>
+    void fill_partial_perm(S* ptr, unsigned char const* src, size_t deg) {
+      for (size_t i = 0; i < deg; ++i) {
+        ptr[i] = load<T>(src + i * sizeof(T));
+      }
+    }
+
+    template <typename T>
+    Obj new_partial_perm(unsigned char const* src, size_t deg) {
+      // The degree of a partial perm in GAP is the largest point in its
+      // domain, and so any trailing 0s must be removed.
+      while (deg > 0 && load<T>(src + (deg - 1) * sizeof(T)) == 0) {
+        deg--;
+      }
+      T codeg = 0;
+      for (size_t i = 0; i < deg; ++i) {
+        codeg = std::max(codeg, load<T>(src + i * sizeof(T)));
+      }
+      Obj x;
+      if (codeg <= UINT16_MAX) {
+        x = NEW_PPERM2(deg);
+        fill_partial_perm<T>(ADDR_PPERM2(x), src, deg);
+        SET_CODEG_PPERM2(x, codeg);
+      } else {
+        x = NEW_PPERM4(deg);
+        fill_partial_perm<T>(ADDR_PPERM4(x), src, deg);
+        SET_CODEG_PPERM4(x, codeg);
+      }
+      return x;
+    }
+
+    template <typename T>
+    Obj new_bipartition(unsigned char const* src, size_t deg) {
+      std::vector<uint32_t> blocks(2 * deg);
+      uint32_t              nr_left_blocks = 0;
+      uint32_t              nr_blocks      = 0;
+      for (size_t i = 0; i < 2 * deg; ++i) {
+        T const val = load<T>(src + i * sizeof(T));
+        if (val >= 2 * deg) {
+          corrupt();
+        }
+        blocks[i] = val;
+        nr_blocks = std::max(nr_blocks, static_cast<uint32_t>(val) + 1);
+        if (i + 1 == deg) {
+          nr_left_blocks = nr_blocks;
+        }
+      }
+      auto* x = new libsemigroups::Bipartition(blocks);
+      x->set_number_of_left_blocks(nr_left_blocks);
+      x->set_number_of_blocks(nr_blocks);
+      return bipart_new_obj(x);
+    }
+
+    // Returns the GAP list of the elements in a record whose values are
+    // stored as T's, <src> points to the first value, and <end> is the end of
+    // the record.
+    template <typename T>
+    Obj decode_record(uint32_t             type,
+                      size_t               k,
+                      unsigned char const* degrees,
+                      unsigned char const* src,
+                      unsigned char const* end) {
+      Obj result = NEW_PLIST(T_PLIST, k);
+      SET_LEN_PLIST(result, k);
+      for (size_t i = 0; i < k; ++i) {
+        size_t const deg = load<uint32_t>(degrees + i * sizeof(uint32_t));
+        size_t const len = (type == BIPARTITION ? 2 * deg : deg);
+        if (static_cast<size_t>(end - src) / sizeof(T) < len) {
+          corrupt();
+        }
+        Obj x;
+        switch (type) {
+          case TRANSFORMATION:
+            x = new_transformation<T>(src, deg);
+            break;
+          case PARTIAL_PERM:
+            x = new_partial_perm<T>(src, deg);
+            break;
+          default:
+            x = new_bipartition<T>(src, deg);
+        }
+        src += len * sizeof(T);
+        SET_ELM_PLIST(result, i + 1, x);
+        CHANGED_BAG(result);
+      }
+      return result;
+    }
+  }  // namespace
+
+  void WRITE_GENERATORS_FILE(std::string filename, Obj collcoll, bool append) {
+    if (!IS_LIST(collcoll)) {
+      throw std::runtime_error("the 2nd argument must be a list");
+    }
+
+    std::vector<uint64_t> index;
+    uint64_t              pos = HEADER_LENGTH * sizeof(uint64_t);
+    std::fstream          file;
+
+    if (append) {
+      file.open(filename, std::ios::in | std::ios::out | std::ios::binary);
+      file.seekg(0, std::ios::end);
+    }
+
+    if (file.is_open() && file.tellg() > 0) {
+      // Read the index of the existing file, the new records overwrite it.
+      uint64_t const file_size = file.tellg();
+      unsigned char  header[HEADER_LENGTH * sizeof(uint64_t)];
+      file.seekg(0);
+      if (!file.read(reinterpret_cast<char*>(header), sizeof(header))) {
+        throw std::runtime_error("the file is not a generators file");
+      }
+      validate_header(header, file_size);
+      pos = load<uint64_t>(header + 8 * HEADER_INDEX);
+      std::vector<unsigned char> buf(file_size - pos);
+      file.seekg(pos);
+      file.read(reinterpret_cast<char*>(buf.data()), buf.size());
+      for (size_t i = 0; i < buf.size(); i += sizeof(uint64_t)) {
+        index.push_back(load<uint64_t>(buf.data() + i));
+      }
+    } else {
+      file.close();
+      file.clear();
+      file.open(filename,
+                std::ios::in | std::ios::out | std::ios::binary
+                    | std::ios::trunc);
+      if (!file) {
+        throw std::runtime_error("cannot open the file for writing");
+      }
+    }
+    file.seekp(pos);
+
+    std::vector<unsigned char> buf;
+    for (size_t i = 1; i <= static_cast<size_t>(LEN_LIST(collcoll)); ++i) {
+      Obj coll = ELM0_LIST(collcoll, i);
+      if (coll == 0) {
+        throw std::runtime_error("the 2nd argument must be a dense list");
+      }
+      buf.clear();
+      encode_record(coll, buf);
+      file.write(reinterpret_cast<char const*>(buf.data()), buf.size());
+      index.push_back(pos);
+      pos += buf.size();
+    }
+
+    buf.clear();
+    for (auto const& val : index) {
+      store<uint64_t>(buf, val);
+    }
+    file.write(reinterpret_cast<char const*>(buf.data()), buf.size());
+
+    buf.clear();
+    store<uint64_t>(buf, MAGIC);
+    store<uint64_t>(buf, VERSION);
+    store<uint64_t>(buf, index.size());
+    store<uint64_t>(buf, pos);
+    buf.resize(HEADER_LENGTH * sizeof(uint64_t), 0);
+    file.seekp(0);
+    file.write(reinterpret_cast<char const*>(buf.data()), buf.size());
+    if (!file) {
+      throw std::runtime_error("error writing to the file");
+    }
+  }
+
+  bool IS_GENERATORS_FILE(std::string filename) {
+    std::ifstream file(filename, std::ios::in | std::ios::binary);
+    unsigned char magic[sizeof(uint64_t)];
+    return file.read(reinterpret_cast<char*>(magic), sizeof(magic))
+           && load<uint64_t>(magic) == MAGIC;
+  }
+
+  // A GeneratorsFile is a read only view of a file written by
+  // WRITE_GENERATORS_FILE. The file is memory mapped, and every record can
+  // be read without reading any of the others, so that opening very large
+  // files, and accessing records in any order, is fast. The records are
+  // indexed from 0.
+  class GeneratorsFile {
+    void*                _addr;
+    size_t               _file_size;
+    unsigned char const* _data;
+    size_t               _number_of_records;
+    uint64_t             _index;
+
+    void reset() {
+      if (_addr != nullptr) {
+        munmap(_addr, _file_size);
+      }
+      _addr              = nullptr;
+      _file_size         = 0;
+      _data              = nullptr;
+      _number_of_records = 0;
+      _index             = 0;
+    }
+
+    uint64_t offset(size_t i) const noexcept {
+      return i == _number_of_records
+                 ? _index
+                 : load<uint64_t>(_data + _index + i * sizeof(uint64_t));
+    }
+
+   public:
+    GeneratorsFile()
+        : _addr(nullptr),
+          _file_size(0),
+          _data(nullptr),
+          _number_of_records(0),
+          _index(0) {}
+
+    GeneratorsFile(GeneratorsFile const&)            = delete;
+    GeneratorsFile(GeneratorsFile&&)                 = delete;
+    GeneratorsFile& operator=(GeneratorsFile const&) = delete;
+    GeneratorsFile& operator=(GeneratorsFile&&)      = delete;
+
+    ~GeneratorsFile() {
+      reset();
+    }
+
+    void init(std::string const& filename) {
+      reset();
+      int fd = open(filename.c_str(), O_RDONLY);
+      if (fd == -1) {
+        throw std::runtime_error("cannot open the file for reading");
+      }
+      struct stat st;
+      if (fstat(fd, &st) == -1
+          || static_cast<size_t>(st.st_size)
+                 < HEADER_LENGTH * sizeof(uint64_t)) {
+        close(fd);
+        throw std::runtime_error("the file is not a generators file");
+      }
+      void* addr = mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+      close(fd);
+      if (addr == MAP_FAILED) {
+        throw std::runtime_error("cannot map the file");
+      }
+      _addr      = addr;
+      _file_size = st.st_size;
+      _data      = static_cast<unsigned char const*>(_addr);
+      try {
+        validate_header(_data, _file_size);
+      } catch (...) {
+        reset();
+        throw;
+      }
+      _number_of_records
+          = load<uint64_t>(_data + 8 * HEADER_NUMBER_OF_RECORDS);
+      _index = load<uint64_t>(_data + 8 * HEADER_INDEX);
+    }
+
+    size_t size() const noexcept {
+      return _number_of_records;
+    }
+
+    Obj record(size_t i) const {
+      if (_addr == nullptr) {
+        throw std::runtime_error("no file has been read");
+      } else if (i >= size()) {
+        throw std::runtime_error("the argument must be less than "
+                                 + std::to_string(size()) + ", found "
+                                 + std::to_string(i));
+      }
+      uint64_t const first = offset(i);
+      uint64_t const last  = offset(i + 1);
+      if (first > last || last > _index
+          || last - first < RECORD_HEADER_LENGTH * sizeof(uint32_t)) {
+        corrupt();
+      }
+      unsigned char const* ptr = _data + first;
+      unsigned char const* end = _data + last;
+
+      uint32_t const type  = load<uint32_t>(ptr + 4 * RECORD_TYPE);
+      uint32_t const width = load<uint32_t>(ptr + 4 * RECORD_WIDTH);
+      size_t const   k     = load<uint32_t>(ptr + 4 * RECORD_LENGTH);
+      ptr += RECORD_HEADER_LENGTH * sizeof(uint32_t);
+      if (type > BIPARTITION
+          || static_cast<size_t>(end - ptr) / sizeof(uint32_t) < k) {
+        corrupt();
+      }
+      unsigned char const* src = ptr + k * sizeof(uint32_t);
+      if (width == 2) {
+        return decode_record<uint16_t>(type, k, ptr, src, end);
+      } else if (width == 4) {
+        return decode_record<uint32_t>(type, k, ptr, src, end);
+      }
+      corrupt();
+    }
+  };
+}  // namespace semigroups
+
+namespace gapbind14 {
+  template <>
+  struct IsGapBind14Type<semigroups::GeneratorsFile> : std::true_type {};
+}  // namespace gapbind14
+
+void init_generators_file(gapbind14::Module& m) {
+  using semigroups::GeneratorsFile;
+
+  gapbind14::class_<GeneratorsFile>("GeneratorsFile")
+      .def(gapbind14::init<>{}, "make")
+      .def("init",
+           [](GeneratorsFile& f, std::string filename) { f.init(filename); })
+      .def("size", &GeneratorsFile::size)
+      .def("record", &GeneratorsFile::record);
+}
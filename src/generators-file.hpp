@@ -0,0 +1,71 @@
+//
+// Semigroups package for GAP
+// Copyright (C) 2025 James D. Mitchell
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+
+// This file contains declarations of functions for writing collections of
+// transformations, partial perms, and bipartitions to a binary file, and
+// reading them back using a memory mapped file.
+//
+// The format of the file (version 1) is as follows, all integers are stored
+// in little endian byte order, regardless of the machine that wrote the file:
+//
+//   header, consisting of 8 uint64_t values:
+//     magic number, version, number of records (r), position of the index,
+//     reserved (0) x 4
+//   records, each of which consists of:
+//     4 uint32_t values: the type of the elements (0 for transformations, 1
+//       for partial perms, 2 for bipartitions), the number w of bytes used
+//       for each value (2 or 4), the number of elements k, reserved (0)
+//     k uint32_t values: the degrees of the elements
+//     the values of the elements, each a w-byte unsigned integer, which are:
+//       transformation of degree n: the images of 1, ..., n minus 1
+//       partial perm of degree n:   the images of 1, ..., n (0 if undefined)
+//       bipartition of degree n:    the IntRepOfBipartition minus 1
+//     0 bytes so that the length of the record is a multiple of 8
+//   index: r uint64_t values, the i-th of which is the position in the file
+//     of the i-th record.
+//
+// The index is at the end of the file so that records can be appended to an
+// existing file without rewriting the records already in it.
+
+#ifndef SEMIGROUPS_SRC_GENERATORS_FILE_HPP_
+#define SEMIGROUPS_SRC_GENERATORS_FILE_HPP_
+
+#include <string>  // for string
+
+#include "compiled.h"  // for Obj
+
+// Forward decl
+namespace gapbind14 {
+  class Module;
+}  // namespace gapbind14
+
+namespace semigroups {
+  // Writes the collections in the GAP list <collcoll>, each of which must be a
+  // list of transformations, partial perms, or bipartitions, to the file with
+  // name <filename>. If <append> is true, then the collections are appended to
+  // the file (if it exists), and otherwise the file is overwritten.
+  void WRITE_GENERATORS_FILE(std::string filename, Obj collcoll, bool append);
+
+  // Returns true if the file with name <filename> exists and starts with the
+  // magic number of the format described above, and false otherwise.
+  bool IS_GENERATORS_FILE(std::string filename);
+}  // namespace semigroups
+
+void init_generators_file(gapbind14::Module&);
+
+#endif  // SEMIGROUPS_SRC_GENERATORS_FILE_HPP_
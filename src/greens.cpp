@@ -0,0 +1,166 @@
+//
+// Semigroups package for GAP
+// Copyright (C) 2025 James D. Mitchell
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+
+// This file contains functions for computing with the Green's classes of
+// acting semigroups. The function PARTIAL_ORDER_OF_DCLASSES is a kernel version
+// of the loop in the PartialOrderOfDClasses method for acting semigroups,
+// which collects the D-classes of the products of the representatives of
+// every D-class and the generators.
+
+#include "greens.hpp"
+
+#include <algorithm>  // for min, sort
+#include <cstddef>    // for size_t
+#include <cstdint>    // for uint32_t
+#include <stdexcept>  // for runtime_error
+#include <string>     // for string, to_string
+#include <vector>     // for vector
+
+// GAP headers
+#include "compiled.h"
+
+// Semigroups package for GAP headers
+#include "bitset.hpp"    // for Bitset
+#include "parallel.hpp"  // for number_of_threads, parallel_for
+
+namespace semigroups {
+  namespace {
+    // Copies the GAP list of lists of integers in the range [1, <max>] into
+    // <flat>, so that the entries (minus 1) of the i-th list are in the range
+    // [offset[i], offset[i + 1]) of <flat>. Unbound entries are skipped.
+    void flatten(Obj                    list,
+                 size_t                 max,
+                 std::vector<uint32_t>& flat,
+                 std::vector<size_t>&   offset) {
+      if (!IS_LIST(list)) {
+        throw std::runtime_error(std::string("expected a list, found ")
+                                 + TNAM_OBJ(list));
+      }
+      flat.clear();
+      offset.assign(1, 0);
+      for (Int i = 1; i <= LEN_LIST(list); ++i) {
+        Obj sublist = ELM0_LIST(list, i);
+        if (sublist != 0) {
+          if (!IS_LIST(sublist)) {
+            throw std::runtime_error(std::string("expected a list, found ")
+                                     + TNAM_OBJ(sublist));
+          }
+          for (Int j = 1; j <= LEN_LIST(sublist); ++j) {
+            Obj x = ELM0_LIST(sublist, j);
+            if (x == 0) {
+              continue;
+            } else if (!IS_INTOBJ(x) || INT_INTOBJ(x) < 1
+                       || static_cast<size_t>(INT_INTOBJ(x)) > max) {
+              throw std::runtime_error(
+                  "expected an integer in the range [1, " + std::to_string(max)
+                  + "]");
+            }
+            flat.push_back(INT_INTOBJ(x) - 1);
+          }
+        }
+        offset.push_back(flat.size());
+      }
+    }
+  }  // namespace
+
+  Obj PARTIAL_ORDER_OF_DCLASSES(Obj graph,
+                                Obj sccs,
+                                Obj lookup,
+                                Obj right,
+                                Obj nr_threads) {
+    size_t const nr_thrds = number_of_threads(nr_threads);
+    if (!IS_LIST(lookup)) {
+      throw std::runtime_error(std::string("expected a list, found ")
+                               + TNAM_OBJ(lookup));
+    } else if (!IS_LIST(sccs) || !IS_LIST(right)
+               || LEN_LIST(sccs) != LEN_LIST(right)) {
+      throw std::runtime_error("expected lists of equal length");
+    }
+    size_t const n = LEN_LIST(sccs);
+    size_t const N = LEN_LIST(lookup);
+
+    // The index of the D-class of every element of the data, where 0 is used
+    // for the elements, such as the first one, not in any D-class.
+    std::vector<uint32_t> dclass(N);
+    for (size_t p = 0; p < N; ++p) {
+      Obj d = ELM_LIST(lookup, p + 1);
+      if (!IS_INTOBJ(d) || INT_INTOBJ(d) < 0
+          || static_cast<size_t>(INT_INTOBJ(d)) > n) {
+        throw std::runtime_error("expected an integer in the range [0, "
+                                 + std::to_string(n) + "]");
+      }
+      dclass[p] = INT_INTOBJ(d);
+    }
+
+    std::vector<uint32_t> graph_flat, sccs_flat, right_flat;
+    std::vector<size_t>   graph_offset, sccs_offset, right_offset;
+    flatten(graph, N, graph_flat, graph_offset);
+    flatten(sccs, graph_offset.size() - 1, sccs_flat, sccs_offset);
+    flatten(right, N, right_flat, right_offset);
+
+    // The rows are processed in chunks, each with its own bitset used to
+    // discard the repeated out-neighbours of a row.
+    std::vector<std::vector<uint32_t>> out(n);
+    size_t const                       chunk     = 1024;
+    size_t const                       nr_chunks = (n + chunk - 1) / chunk;
+    parallel_for(nr_chunks, nr_thrds, [&](size_t k) {
+      Bitset       seen(n + 1);
+      size_t const last = std::min(n, (k + 1) * chunk);
+      for (size_t i = k * chunk; i < last; ++i) {
+        auto& row = out[i];
+        // The D-class i + 1 itself and the dummy 0 are never out-neighbours.
+        seen.set(0);
+        seen.set(i + 1);
+        auto add = [&row, &seen](uint32_t d) {
+          if (!seen.get(d)) {
+            seen.set(d);
+            row.push_back(d);
+          }
+        };
+        for (size_t s = sccs_offset[i]; s < sccs_offset[i + 1]; ++s) {
+          uint32_t const p = sccs_flat[s];
+          for (size_t e = graph_offset[p]; e < graph_offset[p + 1]; ++e) {
+            add(dclass[graph_flat[e]]);
+          }
+        }
+        for (size_t e = right_offset[i]; e < right_offset[i + 1]; ++e) {
+          add(dclass[right_flat[e]]);
+        }
+        for (uint32_t d : row) {
+          seen.reset(d);
+        }
+        seen.reset(i + 1);
+        std::sort(row.begin(), row.end());
+      }
+    });
+
+    Obj result = NEW_PLIST(T_PLIST, n);
+    SET_LEN_PLIST(result, n);
+    for (size_t i = 0; i < n; ++i) {
+      Obj row = NEW_PLIST(out[i].empty() ? T_PLIST_EMPTY : T_PLIST_CYC,
+                          out[i].size());
+      SET_LEN_PLIST(row, out[i].size());
+      for (size_t j = 0; j < out[i].size(); ++j) {
+        SET_ELM_PLIST(row, j + 1, INTOBJ_INT(out[i][j]));
+      }
+      SET_ELM_PLIST(result, i + 1, row);
+      CHANGED_BAG(result);
+    }
+    return result;
+  }
+}  // namespace semigroups
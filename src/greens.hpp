@@ -0,0 +1,48 @@
+//
+// Semigroups package for GAP
+// Copyright (C) 2025 James D. Mitchell
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+
+// This file contains declarations of functions for computing with the Green's
+// classes of acting semigroups.
+
+#ifndef SEMIGROUPS_SRC_GREENS_HPP_
+#define SEMIGROUPS_SRC_GREENS_HPP_
+
+#include "compiled.h"  // for Obj
+
+namespace semigroups {
+  // Returns the out-neighbours of the digraph of the partial order of the
+  // D-classes of an acting semigroup, without loops, and with every list of
+  // out-neighbours sorted. The arguments are:
+  // * <graph>: the orbit graph of the SemigroupData of the semigroup, i.e. the
+  //   positions in the data of the products of the generators and the R-class
+  //   representatives;
+  // * <sccs>: a list whose i-th entry is the list of positions in the data of
+  //   the R-class representatives of the i-th D-class;
+  // * <lookup>: a list whose p-th entry is the index of the D-class of the
+  //   p-th element of the data;
+  // * <right>: a list whose i-th entry is a list of positions in the data of
+  //   products of the L-class representatives of the i-th D-class and the
+  //   generators.
+  Obj PARTIAL_ORDER_OF_DCLASSES(Obj graph,
+                                Obj sccs,
+                                Obj lookup,
+                                Obj right,
+                                Obj nr_threads);
+}  // namespace semigroups
+
+#endif  // SEMIGROUPS_SRC_GREENS_HPP_
@@ -0,0 +1,284 @@
+//
+// Semigroups package for GAP
+// Copyright (C) 2025 James D. Mitchell
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+
+// This file contains functions for counting the idempotents of acting
+// semigroups of transformations and partial perms. These are kernel versions
+// of the loops over the lambda and rho values in the NrIdempotents methods for
+// acting semigroups and their Green's classes, in which IdempotentTester is
+// called for every pair of values. The values are copied into flat arrays
+// once, and the pairs are then tested in parallel.
+
+#include "idempotents.hpp"
+
+#include <algorithm>  // for equal, fill, max
+#include <cstddef>    // for size_t
+#include <cstdint>    // for uint32_t
+#include <stdexcept>  // for runtime_error
+#include <string>     // for string, to_string
+#include <vector>     // for vector
+
+// GAP headers
+#include "compiled.h"
+
+// Semigroups package for GAP headers
+#include "parallel.hpp"  // for number_of_threads, parallel_for
+
+namespace semigroups {
+  namespace {
+    constexpr uint32_t UNDEF = static_cast<uint32_t>(-1);
+
+    // The minimum number of pairs of values to be tested for more than one
+    // thread to be used.
+    constexpr size_t MIN_PAIRS_PER_THREAD = size_t(1) << 14;
+
+    // FlatValues is a copy of some of the values in a GAP list of lists of
+    // non-negative integers, such as a lambda or rho orbit, stored
+    // contiguously. Only those values that are required are copied.
+    class FlatValues {
+     public:
+      explicit FlatValues(Obj values)
+          : _max(), _offset(1, 0), _points(), _slot(), _values(values) {
+        if (!IS_LIST(values)) {
+          throw std::runtime_error(std::string("expected a list, found ")
+                                   + TNAM_OBJ(values));
+        }
+        _slot.assign(LEN_LIST(values), UNDEF);
+      }
+
+      // Copies the values at the positions in the GAP list <positions>, and
+      // returns the indices of these values in *this.
+      std::vector<uint32_t> add(Obj positions) {
+        if (!IS_LIST(positions)) {
+          throw std::runtime_error(std::string("expected a list, found ")
+                                   + TNAM_OBJ(positions));
+        }
+        size_t const          n = _slot.size();
+        std::vector<uint32_t> result;
+        result.reserve(LEN_LIST(positions));
+        for (Int k = 1; k <= LEN_LIST(positions); ++k) {
+          Obj i = ELM_LIST(positions, k);
+          if (!IS_INTOBJ(i) || INT_INTOBJ(i) < 1
+              || static_cast<size_t>(INT_INTOBJ(i)) > n) {
+            throw std::runtime_error("expected an integer in the range [1, "
+                                     + std::to_string(n) + "]");
+          }
+          size_t const pos = INT_INTOBJ(i) - 1;
+          if (_slot[pos] == UNDEF) {
+            _slot[pos] = _max.size();
+            copy(ELM_LIST(_values, pos + 1));
+          }
+          result.push_back(_slot[pos]);
+        }
+        return result;
+      }
+
+      uint32_t const* cbegin(uint32_t i) const noexcept {
+        return _points.data() + _offset[i];
+      }
+
+      uint32_t const* cend(uint32_t i) const noexcept {
+        return _points.data() + _offset[i + 1];
+      }
+
+      size_t size(uint32_t i) const noexcept {
+        return _offset[i + 1] - _offset[i];
+      }
+
+      // Returns the maximum point in the i-th value, or 0 if it is empty.
+      uint32_t max(uint32_t i) const noexcept {
+        return _max[i];
+      }
+
+     private:
+      void copy(Obj val) {
+        if (!IS_LIST(val)) {
+          throw std::runtime_error(std::string("expected a list, found ")
+                                   + TNAM_OBJ(val));
+        }
+        uint32_t max = 0;
+        for (Int k = 1; k <= LEN_LIST(val); ++k) {
+          Obj pt = ELM_LIST(val, k);
+          if (!IS_INTOBJ(pt) || INT_INTOBJ(pt) < 0) {
+            throw std::runtime_error(
+                std::string("expected a non-negative integer, found ")
+                + TNAM_OBJ(pt));
+          }
+          _points.push_back(INT_INTOBJ(pt));
+          max = std::max(max, _points.back());
+        }
+        _max.push_back(max);
+        _offset.push_back(_points.size());
+      }
+
+      std::vector<uint32_t> _max;
+      std::vector<size_t>   _offset;
+      std::vector<uint32_t> _points;
+      std::vector<uint32_t> _slot;
+      Obj                   _values;
+    };
+
+    // There is an idempotent transformation with image set img and flat
+    // kernel ker if and only if the number of kernel classes equals the rank,
+    // and every kernel class contains exactly one point of the image.
+    class TransTester {
+     public:
+      TransTester() : _seen() {}
+
+      bool operator()(FlatValues const& img,
+                      uint32_t          i,
+                      FlatValues const& ker,
+                      uint32_t          j) {
+        size_t const rank = img.size(i);
+        if (rank == 0) {
+          return ker.size(j) == 0;
+        } else if (rank != ker.max(j)) {
+          return false;
+        }
+        _seen.assign(rank + 1, false);
+        uint32_t const* classes = ker.cbegin(j);
+        for (auto it = img.cbegin(i); it < img.cend(i); ++it) {
+          if (*it == 0 || *it > ker.size(j)) {
+            return false;
+          }
+          uint32_t const c = classes[*it - 1];
+          if (c == 0 || _seen[c]) {
+            return false;
+          }
+          _seen[c] = true;
+        }
+        return true;
+      }
+
+     private:
+      std::vector<bool> _seen;
+    };
+
+    // There is an idempotent partial perm with image set img and domain dom
+    // if and only if img and dom are equal.
+    class PPermTester {
+     public:
+      bool operator()(FlatValues const& img,
+                      uint32_t          i,
+                      FlatValues const& dom,
+                      uint32_t          j) const {
+        return img.size(i) == dom.size(j)
+               && std::equal(img.cbegin(i), img.cend(i), dom.cbegin(j));
+      }
+    };
+
+    template <typename Tester>
+    Obj nr_idempotents(Obj lambda,
+                       Obj rho,
+                       Obj lambdas,
+                       Obj rhos,
+                       Obj nr_threads) {
+      size_t nr_thrds = number_of_threads(nr_threads);
+      if (!IS_LIST(lambdas) || !IS_LIST(rhos)) {
+        throw std::runtime_error(std::string("expected lists, found ")
+                                 + TNAM_OBJ(lambdas) + " and "
+                                 + TNAM_OBJ(rhos));
+      } else if (LEN_LIST(lambdas) != LEN_LIST(rhos)) {
+        throw std::runtime_error("expected lists of equal length, found "
+                                 + std::to_string(LEN_LIST(lambdas)) + " and "
+                                 + std::to_string(LEN_LIST(rhos)));
+      }
+
+      size_t const                       n = LEN_LIST(lambdas);
+      FlatValues                         lambda_vals(lambda);
+      FlatValues                         rho_vals(rho);
+      std::vector<std::vector<uint32_t>> lambda_tasks, rho_tasks;
+      lambda_tasks.reserve(n);
+      rho_tasks.reserve(n);
+      for (size_t k = 1; k <= n; ++k) {
+        lambda_tasks.push_back(lambda_vals.add(ELM_LIST(lambdas, k)));
+        rho_tasks.push_back(rho_vals.add(ELM_LIST(rhos, k)));
+      }
+
+      // Every task is split into items, one for each value in the longer of
+      // its two lists, which are tested against every value in the other
+      // list. The items of the k-th task are those in the range [first[k],
+      // first[k + 1]).
+      std::vector<size_t> first(1, 0);
+      size_t              nr_pairs = 0;
+      for (size_t k = 0; k < n; ++k) {
+        size_t const l = lambda_tasks[k].size();
+        size_t const r = rho_tasks[k].size();
+        first.push_back(first.back() + std::max(l, r));
+        nr_pairs += l * r;
+      }
+      if (nr_pairs < MIN_PAIRS_PER_THREAD * nr_thrds) {
+        nr_thrds = std::max(nr_pairs / MIN_PAIRS_PER_THREAD, size_t(1));
+      }
+
+      std::vector<uint32_t> task(first.back());
+      for (size_t k = 0; k < n; ++k) {
+        std::fill(task.begin() + first[k], task.begin() + first[k + 1], k);
+      }
+
+      std::vector<size_t> counts(first.back(), 0);
+      parallel_for(first.back(), nr_thrds, [&](size_t t) {
+        Tester       tester;
+        size_t const k  = task[t];
+        auto const&  ls = lambda_tasks[k];
+        auto const&  rs = rho_tasks[k];
+        size_t       nr = 0;
+        if (ls.size() >= rs.size()) {
+          uint32_t const i = ls[t - first[k]];
+          for (uint32_t j : rs) {
+            nr += tester(lambda_vals, i, rho_vals, j);
+          }
+        } else {
+          uint32_t const j = rs[t - first[k]];
+          for (uint32_t i : ls) {
+            nr += tester(lambda_vals, i, rho_vals, j);
+          }
+        }
+        counts[t] = nr;
+      });
+
+      Obj result = NEW_PLIST(T_PLIST_CYC, n);
+      SET_LEN_PLIST(result, n);
+      for (size_t k = 0; k < n; ++k) {
+        size_t nr = 0;
+        for (size_t t = first[k]; t < first[k + 1]; ++t) {
+          nr += counts[t];
+        }
+        SET_ELM_PLIST(result, k + 1, INTOBJ_INT(nr));
+      }
+      return result;
+    }
+  }  // namespace
+
+  Obj TRANS_NR_IDEMPOTENTS(Obj lambda,
+                           Obj rho,
+                           Obj lambdas,
+                           Obj rhos,
+                           Obj nr_threads) {
+    return nr_idempotents<TransTester>(
+        lambda, rho, lambdas, rhos, nr_threads);
+  }
+
+  Obj PPERM_NR_IDEMPOTENTS(Obj lambda,
+                           Obj rho,
+                           Obj lambdas,
+                           Obj rhos,
+                           Obj nr_threads) {
+    return nr_idempotents<PPermTester>(
+        lambda, rho, lambdas, rhos, nr_threads);
+  }
+}  // namespace semigroups
@@ -0,0 +1,49 @@
+//
+// Semigroups package for GAP
+// Copyright (C) 2025 James D. Mitchell
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+
+// This file contains declarations of functions for counting the idempotents
+// of acting semigroups of transformations and partial perms.
+
+#ifndef SEMIGROUPS_SRC_IDEMPOTENTS_HPP_
+#define SEMIGROUPS_SRC_IDEMPOTENTS_HPP_
+
+#include "compiled.h"  // for Obj
+
+namespace semigroups {
+  // Returns a list whose k-th entry is the number of pairs (i, j) with i in
+  // lambdas[k] and j in rhos[k] such that there is an idempotent
+  // transformation with image set lambda[i] and flat kernel rho[j]. The
+  // arguments <lambda> and <rho> can be any lists, such as the lambda and rho
+  // orbits of an acting semigroup, and only those values whose positions
+  // belong to <lambdas> or <rhos> are accessed.
+  Obj TRANS_NR_IDEMPOTENTS(Obj lambda,
+                           Obj rho,
+                           Obj lambdas,
+                           Obj rhos,
+                           Obj nr_threads);
+
+  // As above, but for partial perms, where lambda[i] is an image set and
+  // rho[j] is a domain.
+  Obj PPERM_NR_IDEMPOTENTS(Obj lambda,
+                           Obj rho,
+                           Obj lambdas,
+                           Obj rhos,
+                           Obj nr_threads);
+}  // namespace semigroups
+
+#endif  // SEMIGROUPS_SRC_IDEMPOTENTS_HPP_
@@ -0,0 +1,860 @@
+//
+// Semigroups package for GAP
+// Copyright (C) 2025 James D. Mitchell
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+
+// This file contains functions for computing with the multiplication tables of
+// semigroups, see isomorph.hpp. Each function copies the table out of GAP
+// once, and creates its result directly, rather than applying GAP functions
+// to every entry of the table.
+
+#include "isomorph.hpp"
+
+#include <algorithm>      // for sort, find, mismatch, any_of, none_of, ...
+#include <cstddef>        // for size_t
+#include <cstdint>        // for uint32_t, uint64_t
+#include <unordered_map>  // for unordered_map
+#include <utility>        // for move, swap
+#include <vector>         // for vector
+
+// GAP headers
+#include "compiled.h"
+
+// Semigroups package for GAP headers
+#include "bitset.hpp"  // for Bitset
+
+namespace semigroups {
+  namespace {
+    [[noreturn]] void not_a_table() {
+      ErrorQuit("the 1st argument must be a non-empty square table of "
+                "integers in the range [1, n], where n is the number of rows",
+                0L,
+                0L);
+    }
+
+    // Checks that <table> is a multiplication table, as described in
+    // isomorph.hpp, and returns the number of rows.
+    size_t validate_table(Obj table) {
+      if (!IS_LIST(table) || LEN_LIST(table) == 0) {
+        not_a_table();
+      }
+      size_t const n = LEN_LIST(table);
+      for (size_t i = 1; i <= n; ++i) {
+        Obj row = ELM0_LIST(table, i);
+        if (row == 0 || !IS_LIST(row)
+            || static_cast<size_t>(LEN_LIST(row)) != n) {
+          not_a_table();
+        }
+        for (size_t j = 1; j <= n; ++j) {
+          Obj x = ELM0_LIST(row, j);
+          if (x == 0 || !IS_INTOBJ(x) || INT_INTOBJ(x) < 1
+              || static_cast<size_t>(INT_INTOBJ(x)) > n) {
+            not_a_table();
+          }
+        }
+      }
+      return n;
+    }
+
+    // Returns the entries of the table <table> with <n> rows, which has
+    // already been validated, minus 1, row by row.
+    template <typename T = uint32_t>
+    std::vector<T> table_to_cpp(Obj table, size_t n) {
+      std::vector<T> result(n * n);
+      for (size_t i = 0; i < n; ++i) {
+        Obj row = ELM_LIST(table, i + 1);
+        for (size_t j = 0; j < n; ++j) {
+          result[i * n + j] = INT_INTOBJ(ELM_LIST(row, j + 1)) - 1;
+        }
+      }
+      return result;
+    }
+
+    template <typename T>
+    Obj table_to_gap(std::vector<T> const& t, size_t n) {
+      Obj result = NEW_PLIST(T_PLIST_TAB_RECT, n);
+      SET_LEN_PLIST(result, n);
+      for (size_t i = 0; i < n; ++i) {
+        Obj row = NEW_PLIST(T_PLIST_CYC, n);
+        SET_LEN_PLIST(row, n);
+        for (size_t j = 0; j < n; ++j) {
+          SET_ELM_PLIST(row, j + 1, INTOBJ_INT(t[i * n + j] + 1));
+        }
+        SET_ELM_PLIST(result, i + 1, row);
+        CHANGED_BAG(result);
+      }
+      return result;
+    }
+
+    // Returns the image of <i> (counting from 0) under the GAP permutation
+    // <p>.
+    size_t image(Obj p, size_t i) {
+      if (TNUM_OBJ(p) == T_PERM2) {
+        return i < DEG_PERM2(p) ? ADDR_PERM2(p)[i] : i;
+      }
+      return i < DEG_PERM4(p) ? ADDR_PERM4(p)[i] : i;
+    }
+
+    void hash_combine(uint64_t& seed, uint64_t val) {
+      seed ^= val + 0x9e3779b97f4a7c16 + (seed << 6) + (seed >> 2);
+    }
+
+    // Returns a hash value of the sorted list of the numbers of occurrences
+    // of the values in <first>, <first> + <step>, ..., i.e. of a row or a
+    // column of a table. <count> is used as workspace, and must be 0 on
+    // entry and exit.
+    uint64_t profile(uint32_t const*       first,
+                     size_t                n,
+                     size_t                step,
+                     std::vector<size_t>&  count,
+                     std::vector<size_t>&  values) {
+      values.clear();
+      for (size_t i = 0; i < n; ++i) {
+        if (count[first[i * step]]++ == 0) {
+          values.push_back(first[i * step]);
+        }
+      }
+      for (auto& x : values) {
+        size_t const c = count[x];
+        count[x]       = 0;
+        x              = c;
+      }
+      std::sort(values.begin(), values.end());
+      uint64_t result = 0;
+      for (auto const& x : values) {
+        hash_combine(result, x);
+      }
+      return result;
+    }
+
+    // Returns the number of elements with the same principal ideal as each
+    // element, where <ideals> are the principal ideals.
+    std::vector<size_t> class_sizes(std::vector<Bitset> const& ideals) {
+      std::unordered_map<size_t, std::vector<size_t>> buckets;
+      for (size_t x = 0; x < ideals.size(); ++x) {
+        buckets[ideals[x].hash()].push_back(x);
+      }
+      std::vector<size_t> result(ideals.size(), 0);
+      for (auto const& bucket : buckets) {
+        for (auto const& x : bucket.second) {
+          for (auto const& y : bucket.second) {
+            if (ideals[x] == ideals[y]) {
+              result[x]++;
+            }
+          }
+        }
+      }
+      return result;
+    }
+
+    // This class implements the search for the lex-least multiplication table
+    // of a semigroup isomorphic to that with multiplication table <table>,
+    // where tables are compared first by their diagonals and then row by row.
+    // A relabelling of the elements is built up by a backtrack search over
+    // ordered partitions of the elements, where the elements in the cell
+    // occupying positions [a, b) are given the labels a, ..., b - 1 in some
+    // order. The entries of the relabelled table, diagonal first, are found
+    // one at a time. When an entry is the same for every order of the cell
+    // containing its column, a block of entries is found at once, and the
+    // cell is split without branching. Otherwise, the search branches on the
+    // element given the next label, keeping only those elements for which the
+    // entry is as small as possible. Branches are pruned by comparing the
+    // entries found so far with those of the least table found so far, and
+    // by the automorphisms found when two relabellings give the same table.
+    //
+    // The table and the relabelled tables are stored using the type T, which
+    // is uint8_t or uint16_t, depending on the size of the table.
+    template <typename T>
+    class SmallestTable {
+      static constexpr size_t npos = static_cast<size_t>(-1);
+
+      struct Partition {
+        explicit Partition(size_t n)
+            : order(n), label(n), start(n, 0), end(n, n) {
+          for (size_t i = 0; i < n; ++i) {
+            order[i] = i;
+            label[i] = i;
+          }
+        }
+
+        std::vector<uint32_t> order;  // label -> element
+        std::vector<uint32_t> label;  // element -> label
+        std::vector<uint32_t> start;  // label -> start of its cell
+        std::vector<uint32_t> end;    // start of a cell -> end of the cell
+
+        bool is_singleton(size_t i) const {
+          return end[start[i]] == start[i] + 1;
+        }
+
+        // Swaps the element <x> to the front of its cell, splits it off, and
+        // returns its label.
+        uint32_t individualise(uint32_t x) {
+          uint32_t const a = start[label[x]];
+          uint32_t const b = end[a];
+          if (b == a + 1) {
+            return a;
+          }
+          uint32_t const y = order[a];
+          std::swap(order[a], order[label[x]]);
+          label[y] = label[x];
+          label[x] = a;
+          end[a]   = a + 1;
+          end[a + 1] = b;
+          for (uint32_t i = a + 1; i < b; ++i) {
+            start[i] = a + 1;
+          }
+          return a;
+        }
+
+        // Moves the elements of <group>, which must belong to the cell
+        // starting at <a>, to the front of that cell, and splits them off.
+        void split(uint32_t a, std::vector<uint32_t> const& group) {
+          uint32_t const b = end[a];
+          uint32_t       i = a;
+          for (auto const& x : group) {
+            uint32_t const y = order[i];
+            std::swap(order[i], order[label[x]]);
+            label[y] = label[x];
+            label[x] = i++;
+          }
+          if (i < b) {
+            end[a] = i;
+            end[i] = b;
+            for (uint32_t j = i; j < b; ++j) {
+              start[j] = i;
+            }
+          }
+        }
+      };
+
+      // The ways of applying a candidate in a branch of the search.
+      enum class branch { row, value, element };
+
+      // A node of the search tree, consisting of a partition and the number
+      // of entries of the key that are determined by it, and, if there are
+      // fewer than n + n ^ 2 such entries, the candidates for the branch
+      // at the next entry.
+      struct Node {
+        explicit Node(size_t n)
+            : P(n), p(0), kind(branch::row), c(0), cands(), partner() {}
+
+        Partition             P;
+        size_t                p;
+        branch                kind;
+        uint32_t              c;  // the label of the column of p
+        std::vector<uint32_t> cands;
+        std::vector<uint32_t> partner;
+      };
+
+      // A child of a node, and the entries of the key determined by the child
+      // but not the node.
+      struct Child {
+        Child(Node const& x, size_t i) : node(x), entries(), index(i) {
+          node.cands.clear();
+          node.partner.clear();
+        }
+
+        Node           node;
+        std::vector<T> entries;
+        size_t         index;  // of the candidate in the parent
+      };
+
+      size_t const          _n;
+      std::vector<T> const  _table;
+      std::vector<T>        _key;  // the diagonal and then the table
+      std::vector<T>        _best;
+      bool                  _found;
+      size_t                _nr_found;
+      std::vector<uint32_t> _best_order;
+      std::vector<size_t>   _path;
+      std::vector<size_t>   _best_path;
+      std::vector<std::vector<uint32_t>> _autos;
+
+     public:
+      SmallestTable(std::vector<T>&& table, size_t n)
+          : _n(n),
+            _table(std::move(table)),
+            _key(n + n * n),
+            _best(),
+            _found(false),
+            _nr_found(0),
+            _best_order(),
+            _path(),
+            _best_path(),
+            _autos() {}
+
+      // Returns the lex-least table, row by row.
+      std::vector<T> run() {
+        Node           root(_n);
+        std::vector<T> entries;
+        bool           less = false;
+        advance(root, entries, less);
+        std::copy(entries.cbegin(), entries.cend(), _key.begin());
+        search(root, false, 0);
+        return std::vector<T>(_best.cbegin() + _n, _best.cend());
+      }
+
+     private:
+      size_t prod(size_t x, size_t y) const {
+        return _table[x * _n + y];
+      }
+
+      // Appends <val>, the entry of the key in position <p>, to <out>, and
+      // returns false if the key is now greater than the best key found so
+      // far. The value of <less> is true if the key is already less than the
+      // best key.
+      bool push(std::vector<T>& out, size_t p, uint32_t val, bool& less) {
+        if (_found && !less) {
+          if (val > _best[p]) {
+            return false;
+          } else if (val < _best[p]) {
+            less = true;
+          }
+        }
+        out.push_back(val);
+        return true;
+      }
+
+      // Returns the element whose label is the entry in position <p> of the
+      // key when <y> has the label of the column of this position.
+      uint32_t phi(Partition const& P, size_t p, uint32_t y) const {
+        if (p < _n) {
+          return prod(y, y);
+        }
+        return prod(P.order[(p - _n) / _n], y);
+      }
+
+      // Returns true if the automorphism <g> maps every cell of <P> to
+      // itself.
+      bool stabilises(Partition const& P, std::vector<uint32_t> const& g) {
+        for (size_t x = 0; x < _n; ++x) {
+          if (P.start[P.label[g[x]]] != P.start[P.label[x]]) {
+            return false;
+          }
+        }
+        return true;
+      }
+
+      // Returns the representative of <x> in the union-find table <uf>.
+      static uint32_t find(std::vector<uint32_t>& uf, uint32_t x) {
+        while (uf[x] != x) {
+          uf[x] = uf[uf[x]];
+          x     = uf[x];
+        }
+        return x;
+      }
+
+      // Finds the entries of the key, from position x.p, that are determined
+      // by the partition of <x>, refining it where this does not involve a
+      // choice, and appends them to <out>. Stops at the first entry where a
+      // choice must be made, and sets the candidates of <x>. Returns false if
+      // the key is greater than the best key found so far.
+      bool advance(Node& x, std::vector<T>& out, bool& less) {
+        size_t const          nr_positions = _key.size();
+        Partition&            P            = x.P;
+        size_t&               p            = x.p;
+        uint32_t&             c            = x.c;
+        std::vector<uint32_t> group;
+
+        while (p < nr_positions) {
+          if (p >= _n) {
+            size_t const r = (p - _n) / _n;
+            c              = (p - _n) % _n;
+            if (c == 0 && !P.is_singleton(r)) {
+              x.kind = branch::row;
+              for (uint32_t i = r; i < P.end[r]; ++i) {
+                x.cands.push_back(P.order[i]);
+              }
+              return true;
+            }
+          } else {
+            c = p;
+          }
+          uint32_t const b = P.end[c];
+          if (b == c + 1) {
+            if (!push(out, p, P.individualise(phi(P, p, P.order[c])), less)) {
+              return false;
+            }
+            p++;
+            continue;
+          }
+          // The cell in positions [c, b) is not a singleton. For every
+          // element y in this cell, we find the least possible entry in
+          // position p when y is given the label c.
+          uint32_t min_ext  = _n;  // over y with phi(y) not in the cell
+          bool     has_self = false;
+          for (uint32_t i = c; i < b; ++i) {
+            uint32_t const y = P.order[i];
+            uint32_t const v = phi(P, p, y);
+            uint32_t const l = P.label[v];
+            if (v == y) {
+              has_self = true;
+            } else if (l < c || l >= b) {
+              min_ext = std::min(min_ext, P.start[l]);
+            }
+          }
+          group.clear();
+          if (min_ext < c) {
+            // Every element y with phi(y) = v in the cell with least start
+            // has a smaller entry than any other element, and so these
+            // elements get the next labels in any order.
+            for (uint32_t i = c; i < b; ++i) {
+              uint32_t const v = phi(P, p, P.order[i]);
+              if (P.start[P.label[v]] == min_ext
+                  && std::find(x.cands.cbegin(), x.cands.cend(), v)
+                         == x.cands.cend()) {
+                x.cands.push_back(v);
+              }
+            }
+            if (x.cands.size() > 1) {
+              x.kind = branch::value;
+              return true;
+            }
+            P.individualise(x.cands[0]);
+            for (uint32_t i = c; i < b; ++i) {
+              if (phi(P, p, P.order[i]) == x.cands[0]) {
+                group.push_back(P.order[i]);
+              }
+            }
+            x.cands.clear();
+            P.split(c, group);
+            for (size_t i = 0; i < group.size(); ++i) {
+              if (!push(out, p++, min_ext, less)) {
+                return false;
+              }
+            }
+            continue;
+          } else if (has_self) {
+            // If no other element y in the cell has phi(y) equal to an
+            // element x with phi(x) = x, then the elements x get the next
+            // labels in any order, and the entry for each is its own label.
+            for (uint32_t i = c; i < b; ++i) {
+              uint32_t const y = P.order[i];
+              if (phi(P, p, y) == y) {
+                group.push_back(y);
+              }
+            }
+            bool roots = false;
+            for (uint32_t i = c; i < b && !roots; ++i) {
+              uint32_t const y = P.order[i];
+              uint32_t const v = phi(P, p, y);
+              roots = v != y && phi(P, p, v) == v && P.start[P.label[v]] == c;
+            }
+            if (!roots) {
+              P.split(c, group);
+              for (size_t i = 0; i < group.size(); ++i) {
+                if (!push(out, p++, c + i, less)) {
+                  return false;
+                }
+              }
+              continue;
+            }
+          }
+          // Otherwise, branch on the element with label c.
+          x.kind             = branch::element;
+          uint32_t min_entry = _n;
+          for (uint32_t i = c; i < b; ++i) {
+            uint32_t const y = P.order[i];
+            uint32_t const v = phi(P, p, y);
+            uint32_t const l = P.label[v];
+            uint32_t       e;
+            if (v == y) {
+              e = c;
+            } else if (l >= c && l < b) {
+              e = c + 1;
+            } else {
+              e = P.start[l];
+            }
+            if (e < min_entry) {
+              min_entry = e;
+              x.cands.clear();
+            }
+            if (e == min_entry) {
+              x.cands.push_back(y);
+            }
+          }
+          // If phi(y) = v and phi(v) = y for distinct y and v in the cell,
+          // then giving y the label c, and so v the label c + 1, and giving v
+          // the label c, and so y the label c + 1, give the same entries in
+          // positions p and p + 1. We branch on both orders at once by
+          // splitting off the cell {y, v}.
+          x.partner.assign(x.cands.size(), _n);
+          if (min_entry == c + 1) {
+            size_t k = 0;
+            for (size_t i = 0; i < x.cands.size(); ++i) {
+              uint32_t const y = x.cands[i];
+              uint32_t const v = phi(P, p, y);
+              if (phi(P, p, v) != y) {
+                x.cands[k++] = y;
+              } else if (P.label[v] > P.label[y]) {
+                x.partner[k] = v;
+                x.cands[k++] = y;
+              }
+            }
+            x.cands.resize(k);
+            x.partner.resize(k);
+          }
+          return true;
+        }
+        return true;
+      }
+
+      // Applies the candidate of the parent <x> with index ch.index to the
+      // child <ch>, and then advances it. Returns false if the key of the
+      // child is greater than the best key found so far.
+      bool apply(Node const& x, Child& ch, bool& less) {
+        Partition&     P = ch.node.P;
+        size_t&        p = ch.node.p;
+        uint32_t const y = x.cands[ch.index];
+        uint32_t const c = x.c;
+        if (x.kind == branch::row) {
+          P.individualise(y);
+        } else if (x.kind == branch::value) {
+          uint32_t const        val = P.individualise(y);
+          std::vector<uint32_t> group;
+          for (uint32_t i = c; i < P.end[c]; ++i) {
+            if (phi(P, p, P.order[i]) == y) {
+              group.push_back(P.order[i]);
+            }
+          }
+          P.split(c, group);
+          for (size_t i = 0; i < group.size(); ++i) {
+            if (!push(ch.entries, p++, val, less)) {
+              return false;
+            }
+          }
+        } else if (x.partner[ch.index] != _n) {
+          P.split(c, {y, x.partner[ch.index]});
+          if (!push(ch.entries, p++, c + 1, less)
+              || !push(ch.entries, p++, c, less)) {
+            return false;
+          }
+        } else {
+          P.individualise(y);
+          if (!push(ch.entries, p, P.individualise(phi(P, p, y)), less)) {
+            return false;
+          }
+          p++;
+        }
+        return advance(ch.node, ch.entries, less);
+      }
+
+      // Returns true if the entries <a> and <b> differ before the end of
+      // either, and the first entry that differs is greater in <a>.
+      static bool dominated(std::vector<T> const& a, std::vector<T> const& b) {
+        auto const m = std::mismatch(
+            a.cbegin(), a.cbegin() + std::min(a.size(), b.size()), b.cbegin());
+        return m.first != a.cbegin() + std::min(a.size(), b.size())
+               && *m.first > *m.second;
+      }
+
+      // Returns true if the entries <a> are less than <b>, where the end of
+      // either is greater than any entry. This is used to order the children
+      // of a node, so that those that are determined furthest are tried
+      // first when their entries agree.
+      static bool before(std::vector<T> const& a, std::vector<T> const& b) {
+        auto const m = std::mismatch(
+            a.cbegin(), a.cbegin() + std::min(a.size(), b.size()), b.cbegin());
+        if (m.first != a.cbegin() + std::min(a.size(), b.size())) {
+          return *m.first < *m.second;
+        }
+        return a.size() > b.size();
+      }
+
+      // Returns the depth of a node to return to, or npos, where <less> is
+      // true if the key of <x> is less than the best key.
+      size_t search(Node const& x, bool less, size_t depth) {
+        if (x.p == _key.size()) {
+          if (!_found || less) {
+            _found = true;
+            _nr_found++;
+            _best       = _key;
+            _best_order = x.P.order;
+            _best_path  = _path;
+            return npos;
+          }
+          // The key equals the best key, and so relabelling by the best
+          // labels is an automorphism. The branches after the one where the
+          // current path leaves the best path give the same keys as that
+          // branch, and so we return to it.
+          std::vector<uint32_t> g(_n);
+          for (size_t y = 0; y < _n; ++y) {
+            g[y] = _best_order[x.P.label[y]];
+          }
+          _autos.push_back(std::move(g));
+          size_t d = 0;
+          while (d < _path.size() && d < _best_path.size()
+                 && _path[d] == _best_path[d]) {
+            d++;
+          }
+          return d;
+        }
+
+        // Find every child up to its next branch, discard those whose entries
+        // are greater than those of another child before either branches,
+        // and try the rest in order of their entries.
+        std::vector<Child> children;
+        children.reserve(x.cands.size());
+        for (size_t i = 0; i < x.cands.size(); ++i) {
+          children.emplace_back(x, i);
+          bool l = less;
+          if (!apply(x, children.back(), l)) {
+            children.pop_back();
+          }
+        }
+        std::sort(children.begin(),
+                  children.end(),
+                  [](Child const& a, Child const& b) {
+                    return before(a.entries, b.entries);
+                  });
+        size_t k = 0;
+        for (size_t i = 0; i < children.size(); ++i) {
+          if (std::none_of(children.cbegin(),
+                           children.cbegin() + k,
+                           [&children, i](Child const& ch) {
+                             return dominated(children[i].entries,
+                                              ch.entries);
+                           })) {
+            if (k != i) {
+              children[k] = std::move(children[i]);
+            }
+            k++;
+          }
+        }
+        children.erase(children.begin() + k, children.end());
+
+        // Skip the children whose candidates are in the same orbit as one
+        // already tried under the automorphisms stabilising the partition.
+        size_t                nr_found = _nr_found;
+        size_t                nr_autos = 0;
+        std::vector<uint32_t> uf(_n);
+        std::vector<uint32_t> tried;
+        for (size_t i = 0; i < children.size(); ++i) {
+          uint32_t const y = x.cands[children[i].index];
+          if (nr_autos != _autos.size()) {
+            for (uint32_t z = 0; z < _n; ++z) {
+              uf[z] = z;
+            }
+            for (auto const& g : _autos) {
+              if (stabilises(x.P, g)) {
+                for (uint32_t z = 0; z < _n; ++z) {
+                  uf[find(uf, z)] = find(uf, g[z]);
+                }
+              }
+            }
+            nr_autos = _autos.size();
+          }
+          if (nr_autos != 0
+              && std::any_of(tried.cbegin(), tried.cend(), [&](uint32_t z) {
+                   return find(uf, z) == find(uf, y);
+                 })) {
+            continue;
+          }
+          tried.push_back(y);
+          if (x.kind == branch::element && x.partner[children[i].index] != _n) {
+            tried.push_back(x.partner[children[i].index]);
+          }
+          // If a new best key was found in the previous children, then the
+          // key before position x.p is equal to the best key.
+          if (nr_found != _nr_found) {
+            less     = false;
+            nr_found = _nr_found;
+          }
+          bool l = less;
+          if (_found && !l) {
+            auto const m = std::mismatch(children[i].entries.cbegin(),
+                                         children[i].entries.cend(),
+                                         _best.cbegin() + x.p);
+            if (m.first != children[i].entries.cend()) {
+              if (*m.first > *m.second) {
+                continue;
+              }
+              l = true;
+            }
+          }
+          std::copy(children[i].entries.cbegin(),
+                    children[i].entries.cend(),
+                    _key.begin() + x.p);
+          _path.push_back(i);
+          size_t const result = search(children[i].node, l, depth + 1);
+          _path.pop_back();
+          if (result != npos && result < depth) {
+            return result;
+          }
+        }
+        return npos;
+      }
+    };
+  }  // namespace
+
+  Obj CANONICAL_DIGRAPH_OUT_NEIGHBOURS(Obj table) {
+    size_t const                n = validate_table(table);
+    std::vector<uint32_t> const t = table_to_cpp(table, n);
+
+    // The vertices are numbered as follows, where x and y are in [1, n]:
+    //
+    //   x:             the element x,
+    //   x * n + y:     the pair (x, y),
+    //   n ^ 2 + n + x: a widget marking the pair (x, x),
+    //
+    // and the edges are x -> (x, y), (x, y) -> x * y, (x, x) -> widget(x),
+    // and (x, y) -> (z, y) for every z <> x. The vertices are coloured
+    // according to these three kinds in SEMIGROUPS.CanonicalDigraph.
+    auto pair   = [n](size_t x, size_t y) { return x * n + y; };
+    auto widget = [n](size_t x) { return n * n + n + x; };
+
+    size_t const nr     = n * n + 2 * n;
+    Obj          result = NEW_PLIST(T_PLIST, nr);
+    SET_LEN_PLIST(result, nr);
+    for (size_t x = 1; x <= n; ++x) {
+      Obj out = NEW_PLIST(T_PLIST_CYC, n);
+      SET_LEN_PLIST(out, n);
+      for (size_t y = 1; y <= n; ++y) {
+        SET_ELM_PLIST(out, y, INTOBJ_INT(pair(x, y)));
+      }
+      SET_ELM_PLIST(result, x, out);
+      CHANGED_BAG(result);
+    }
+    for (size_t x = 1; x <= n; ++x) {
+      for (size_t y = 1; y <= n; ++y) {
+        size_t const len = (x == y ? n + 1 : n);
+        Obj          out = NEW_PLIST(T_PLIST_CYC, len);
+        SET_LEN_PLIST(out, len);
+        size_t k = 1;
+        if (x == y) {
+          SET_ELM_PLIST(out, k++, INTOBJ_INT(widget(x)));
+        }
+        SET_ELM_PLIST(
+            out, k++, INTOBJ_INT(t[(x - 1) * n + (y - 1)] + 1));
+        for (size_t z = 1; z <= n; ++z) {
+          if (z != x) {
+            SET_ELM_PLIST(out, k++, INTOBJ_INT(pair(z, y)));
+          }
+        }
+        SET_ELM_PLIST(result, pair(x, y), out);
+        CHANGED_BAG(result);
+      }
+    }
+    for (size_t x = 1; x <= n; ++x) {
+      SET_ELM_PLIST(result, widget(x), NEW_PLIST(T_PLIST_EMPTY, 0));
+      CHANGED_BAG(result);
+    }
+    return result;
+  }
+
+  Obj ON_MULTIPLICATION_TABLE(Obj table, Obj p) {
+    size_t const n = validate_table(table);
+    if (TNUM_OBJ(p) != T_PERM2 && TNUM_OBJ(p) != T_PERM4) {
+      ErrorQuit("the 2nd argument must be a permutation (not a %s)",
+                (Int) TNAM_OBJ(p),
+                0L);
+    }
+    for (size_t i = 0; i < n; ++i) {
+      if (image(p, i) >= n) {
+        ErrorQuit("the 2nd argument (a permutation) must map [1 .. %d] to "
+                  "itself",
+                  (Int) n,
+                  0L);
+      }
+    }
+    std::vector<uint32_t> const t = table_to_cpp(table, n);
+    std::vector<uint32_t>       q(n);
+    for (size_t i = 0; i < n; ++i) {
+      q[i] = image(p, i);
+    }
+    // The product of i ^ p and j ^ p is (i * j) ^ p.
+    std::vector<uint32_t> result(n * n);
+    for (size_t i = 0; i < n; ++i) {
+      for (size_t j = 0; j < n; ++j) {
+        result[q[i] * n + q[j]] = q[t[i * n + j]];
+      }
+    }
+    return table_to_gap(result, n);
+  }
+
+  Obj MULTIPLICATION_TABLE_INVARIANT(Obj table) {
+    size_t const                n = validate_table(table);
+    std::vector<uint32_t> const t = table_to_cpp(table, n);
+    auto prod = [&t, n](size_t x, size_t y) -> size_t { return t[x * n + y]; };
+
+    // The principal ideals xS ^ 1 and S ^ 1 x, and the number of times that
+    // every element occurs in the table.
+    std::vector<Bitset>   right(n, Bitset(n));
+    std::vector<Bitset>   left(n, Bitset(n));
+    std::vector<uint64_t> occurrences(n, 0);
+    for (size_t x = 0; x < n; ++x) {
+      right[x].set(x);
+      left[x].set(x);
+      for (size_t y = 0; y < n; ++y) {
+        right[x].set(prod(x, y));
+        left[y].set(prod(x, y));
+        occurrences[prod(x, y)]++;
+      }
+    }
+    std::vector<size_t> const r_class_size = class_sizes(right);
+    std::vector<size_t> const l_class_size = class_sizes(left);
+
+    // The invariant of an element x consists of whether or not x is an
+    // idempotent, the index and period of x, the numbers computed above, and
+    // the numbers of occurrences of the values in the row and column of x.
+    std::vector<uint64_t> invariants(n);
+    std::vector<size_t>   stamp(n, 0), position(n, 0);
+    std::vector<size_t>   count(n, 0), values;
+    for (size_t x = 0; x < n; ++x) {
+      size_t y = x, k = 1;
+      while (stamp[y] != x + 1) {
+        stamp[y]    = x + 1;
+        position[y] = k++;
+        y           = prod(y, x);
+      }
+      uint64_t& val = invariants[x];
+      hash_combine(val, prod(x, x) == x);
+      hash_combine(val, position[y]);
+      hash_combine(val, k - position[y]);
+      hash_combine(val, occurrences[x]);
+      hash_combine(val, right[x].count());
+      hash_combine(val, left[x].count());
+      hash_combine(val, r_class_size[x]);
+      hash_combine(val, l_class_size[x]);
+      hash_combine(val, profile(t.data() + x * n, n, 1, count, values));
+      hash_combine(val, profile(t.data() + x, n, n, count, values));
+    }
+    std::sort(invariants.begin(), invariants.end());
+    uint64_t result = n;
+    for (auto const& val : invariants) {
+      hash_combine(result, val);
+    }
+    return ObjInt_UInt8(result);
+  }
+
+  Obj SMALLEST_MULTIPLICATION_TABLE(Obj table) {
+    size_t const n = validate_table(table);
+    if (n <= 256) {
+      return table_to_gap(
+          SmallestTable<uint8_t>(table_to_cpp<uint8_t>(table, n), n).run(),
+          n);
+    } else if (n <= 65536) {
+      return table_to_gap(
+          SmallestTable<uint16_t>(table_to_cpp<uint16_t>(table, n), n).run(),
+          n);
+    }
+    ErrorQuit("the argument (a multiplication table) must have at most 65536 "
+              "rows, found %d",
+              (Int) n,
+              0L);
+    return 0L;
+  }
+}  // namespace semigroups
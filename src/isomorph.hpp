@@ -0,0 +1,56 @@
+//
+// Semigroups package for GAP
+// Copyright (C) 2025 James D. Mitchell
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+
+// This file contains declarations of functions for computing with the
+// multiplication tables of semigroups, which are used to find canonical forms
+// of, and isomorphisms between, semigroups in gap/attributes/isomorph.gi.
+//
+// The multiplication tables passed to these functions must be non-empty
+// square tables of integers in the range [1, n], where n is the number of
+// rows.
+
+#ifndef SEMIGROUPS_SRC_ISOMORPH_HPP_
+#define SEMIGROUPS_SRC_ISOMORPH_HPP_
+
+#include "compiled.h"  // for Obj
+
+namespace semigroups {
+  // Returns the out-neighbours of the vertex coloured digraph, used by
+  // SEMIGROUPS.CanonicalDigraph, whose canonical labellings and isomorphisms
+  // correspond to those of the semigroup with multiplication table <table>.
+  Obj CANONICAL_DIGRAPH_OUT_NEIGHBOURS(Obj table);
+
+  // Returns the multiplication table obtained from <table> by relabelling
+  // every element i by i ^ p, where p must map [1 .. Length(table)] to
+  // itself. This is OnMultiplicationTable.
+  Obj ON_MULTIPLICATION_TABLE(Obj table, Obj p);
+
+  // Returns an integer, computed from the idempotents, the powers, and the
+  // principal one-sided ideals of the elements of the semigroup with
+  // multiplication table <table>, that is the same for multiplication tables
+  // of isomorphic semigroups.
+  Obj MULTIPLICATION_TABLE_INVARIANT(Obj table);
+
+  // Returns the lex-least multiplication table of a semigroup isomorphic to
+  // the semigroup with multiplication table <table>, where the tables are
+  // compared first by their diagonals, and then row by row. This is
+  // SmallestMultiplicationTable.
+  Obj SMALLEST_MULTIPLICATION_TABLE(Obj table);
+}  // namespace semigroups
+
+#endif  // SEMIGROUPS_SRC_ISOMORPH_HPP_
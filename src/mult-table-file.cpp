@@ -0,0 +1,179 @@
+//
+// Semigroups package for GAP
+// Copyright (C) 2025 James D. Mitchell
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+
+// This file contains functions for encoding and decoding the multiplication
+// tables in the files written by WriteMultiplicationTable, see
+// mult-table-file.hpp for a description of the format. Every function makes a
+// single pass over its input, so that reading or writing a file of tables
+// requires only one kernel call, rather than a GAP loop over every entry.
+
+#include "mult-table-file.hpp"
+
+#include <cmath>    // for sqrt
+#include <cstddef>  // for size_t
+#include <cstring>  // for memchr
+
+// GAP headers
+#include "compiled.h"
+
+namespace semigroups {
+  namespace {
+    // Returns the integer square root of n, i.e. the largest k with k ^ 2 at
+    // most n.
+    size_t isqrt(size_t n) {
+      size_t k = static_cast<size_t>(std::sqrt(static_cast<double>(n)));
+      while (k * k > n) {
+        k--;
+      }
+      while ((k + 1) * (k + 1) <= n) {
+        k++;
+      }
+      return k;
+    }
+
+    // Returns the multiplication table encoded in the <len> bytes of the GAP
+    // string <str> starting at <pos>.
+    Obj decode_table(Obj str, size_t pos, size_t len) {
+      size_t const n = multiplication_table_degree(len);
+      Obj table = NEW_PLIST(n == 0 ? T_PLIST_EMPTY : T_PLIST_TAB_RECT, n);
+      SET_LEN_PLIST(table, n);
+      for (size_t i = 0; i < n; ++i) {
+        Obj row = NEW_PLIST(T_PLIST_CYC, n);
+        SET_LEN_PLIST(row, n);
+        // NEW_PLIST can trigger a garbage collection, which can move <str>,
+        // so the pointer to its characters is only obtained here.
+        auto ptr = reinterpret_cast<UInt1 const*>(CONST_CSTR_STRING(str))
+                   + pos + i * n;
+        for (size_t j = 0; j < n; ++j) {
+          SET_ELM_PLIST(row, j + 1, INTOBJ_INT(ptr[j] == 0 ? 10 : ptr[j]));
+        }
+        SET_ELM_PLIST(table, i + 1, row);
+        CHANGED_BAG(table);
+      }
+      return table;
+    }
+
+    [[noreturn]] void not_rectangular() {
+      ErrorQuit("the 2nd argument is not a collection of rectangular tables "
+                "containing only integers",
+                0L,
+                0L);
+    }
+
+    // Checks that <table> is a square table of integers in the range [1, n],
+    // where n is the number of rows, and that n is at most 255, and returns n.
+    size_t validate_table(Obj table) {
+      if (!IS_LIST(table) || LEN_LIST(table) == 0) {
+        not_rectangular();
+      }
+      size_t const n = LEN_LIST(table);
+      for (size_t i = 1; i <= n; ++i) {
+        Obj row = ELM0_LIST(table, i);
+        if (row == 0 || !IS_LIST(row)
+            || static_cast<size_t>(LEN_LIST(row)) != n) {
+          not_rectangular();
+        }
+        for (size_t j = 1; j <= n; ++j) {
+          Obj x = ELM0_LIST(row, j);
+          if (x == 0 || !IS_INTOBJ(x)) {
+            not_rectangular();
+          }
+        }
+      }
+      if (n > 255) {
+        ErrorQuit("the 2nd argument is not a collection of rectangular tables "
+                  "with at most 255 rows",
+                  0L,
+                  0L);
+      }
+      for (size_t i = 1; i <= n; ++i) {
+        Obj row = ELM_LIST(table, i);
+        for (size_t j = 1; j <= n; ++j) {
+          Int const x = INT_INTOBJ(ELM_LIST(row, j));
+          if (x < 1 || static_cast<size_t>(x) > n) {
+            ErrorQuit("the 2nd argument is not a collection of rectangular "
+                      "tables with integer entries from [1, 2, ..., n] (where "
+                      "n equals the number of rows of the table)",
+                      0L,
+                      0L);
+          }
+        }
+      }
+      return n;
+    }
+  }  // namespace
+
+  size_t multiplication_table_degree(size_t len) {
+    size_t const n = isqrt(len);
+    if (n * n != len) {
+      ErrorQuit("the file is corrupt, found a line of length %d, expected a "
+                "square",
+                (Int) len,
+                0L);
+    }
+    return n;
+  }
+
+  Obj DECODE_MULTIPLICATION_TABLES(Obj str) {
+    if (!IS_STRING_REP(str)) {
+      ErrorQuit("expected a string, found %s", (Int) TNAM_OBJ(str), 0L);
+    }
+    size_t const total  = GET_LEN_STRING(str);
+    Obj          result = NEW_PLIST(T_PLIST, 0);
+    size_t       pos    = 0;
+    while (pos < total) {
+      char const* first = CONST_CSTR_STRING(str) + pos;
+      char const* last
+          = static_cast<char const*>(std::memchr(first, '\n', total - pos));
+      size_t const len = (last == nullptr ? total - pos : last - first);
+      Obj          table = decode_table(str, pos, len);
+      PushPlist(result, table);
+      pos += len + 1;
+    }
+    return result;
+  }
+
+  Obj ENCODE_MULTIPLICATION_TABLES(Obj tables) {
+    if (!IS_LIST(tables)) {
+      not_rectangular();
+    }
+    size_t const nr    = LEN_LIST(tables);
+    size_t       total = 0;
+    for (size_t k = 1; k <= nr; ++k) {
+      size_t const n = validate_table(ELM_LIST(tables, k));
+      total += n * n + 1;
+    }
+
+    Obj result = NEW_STRING(total);
+    // Nothing below allocates, and so the pointer into <result> stays valid.
+    UInt1* ptr = CHARS_STRING(result);
+    for (size_t k = 1; k <= nr; ++k) {
+      Obj          table = ELM_LIST(tables, k);
+      size_t const n     = LEN_LIST(table);
+      for (size_t i = 1; i <= n; ++i) {
+        Obj row = ELM_LIST(table, i);
+        for (size_t j = 1; j <= n; ++j) {
+          Int const x = INT_INTOBJ(ELM_LIST(row, j));
+          *ptr++      = (x == 10 ? 0 : x);
+        }
+      }
+      *ptr++ = '\n';
+    }
+    return result;
+  }
+}  // namespace semigroups
@@ -0,0 +1,47 @@
+//
+// Semigroups package for GAP
+// Copyright (C) 2025 James D. Mitchell
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+
+// This file contains declarations of functions for encoding and decoding the
+// multiplication tables in the files written by WriteMultiplicationTable.
+// Every table is stored in a single line, consisting of the n ^ 2 entries of
+// the table, row by row, each as a single byte, followed by a newline. The
+// entry 10 is stored as 0, since 10 is the newline character.
+
+#ifndef SEMIGROUPS_SRC_MULT_TABLE_FILE_HPP_
+#define SEMIGROUPS_SRC_MULT_TABLE_FILE_HPP_
+
+#include <cstddef>  // for size_t
+
+#include "compiled.h"  // for Obj
+
+namespace semigroups {
+  // Returns the number of rows of the multiplication table encoded in a line
+  // of length <len>, i.e. the square root of <len>, or throws a GAP error if
+  // <len> is not a square.
+  size_t multiplication_table_degree(size_t len);
+
+  // Returns the list of multiplication tables stored in the lines of the GAP
+  // string <str>. The final line of <str> need not end in a newline.
+  Obj DECODE_MULTIPLICATION_TABLES(Obj str);
+
+  // Returns a GAP string containing the lines encoding the multiplication
+  // tables in the GAP list <tables>.
+  Obj ENCODE_MULTIPLICATION_TABLES(Obj tables);
+}  // namespace semigroups
+
+#endif  // SEMIGROUPS_SRC_MULT_TABLE_FILE_HPP_
@@ -0,0 +1,313 @@
+//
+// Semigroups package for GAP
+// Copyright (C) 2025 James D. Mitchell
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+
+// This file contains a function for computing some properties of many small
+// semigroups, given by their multiplication tables, at once. The tables are
+// copied out of GAP once, the properties of the semigroups are computed in
+// parallel without creating any GAP objects, and only the values of the
+// properties are returned to GAP.
+
+#include "mult-table-props.hpp"
+
+#include <algorithm>  // for min
+#include <cstddef>    // for size_t
+#include <cstdint>    // for uint8_t, uint32_t
+#include <cstring>    // for memchr
+#include <vector>     // for vector
+
+// GAP headers
+#include "compiled.h"
+
+// Semigroups package for GAP headers
+#include "bitset.hpp"           // for Bitset
+#include "mult-table-file.hpp"  // for multiplication_table_degree
+#include "parallel.hpp"         // for number_of_threads, parallel_for
+
+namespace semigroups {
+  namespace {
+    // The number of tables processed by a thread at a time.
+    constexpr size_t TABLES_PER_CHUNK = 256;
+
+    struct Properties {
+      uint32_t nr_idempotents;
+      uint32_t nr_r_classes;
+      uint32_t nr_l_classes;
+      uint32_t nr_h_classes;
+      uint32_t nr_d_classes;
+      bool     is_band;
+      bool     is_commutative;
+      bool     is_monoid;
+      bool     is_regular;
+      bool     is_inverse;
+      bool     is_clifford;
+      bool     is_group;
+      bool     is_simple;
+    };
+
+    // Returns the index of the first entry of <reps> equal to <x>, after
+    // adding <x> to the end of <reps> if there is no such entry.
+    size_t class_index(std::vector<Bitset>& reps, Bitset const& x) {
+      for (size_t i = 0; i < reps.size(); ++i) {
+        if (reps[i] == x) {
+          return i;
+        }
+      }
+      reps.push_back(x);
+      return reps.size() - 1;
+    }
+
+    // Returns the properties of the semigroup with the n x n multiplication
+    // table <t>, whose entries are in the range [0, n).
+    Properties properties(uint8_t const* t, size_t n) {
+      auto prod = [t, n](size_t x, size_t y) -> size_t { return t[x * n + y]; };
+
+      Properties result = {};
+
+      std::vector<size_t> idempotents;
+      for (size_t x = 0; x < n; ++x) {
+        if (prod(x, x) == x) {
+          idempotents.push_back(x);
+        }
+      }
+      result.nr_idempotents = idempotents.size();
+      result.is_band        = (idempotents.size() == n);
+
+      result.is_commutative = true;
+      for (size_t x = 0; x < n && result.is_commutative; ++x) {
+        for (size_t y = x + 1; y < n; ++y) {
+          if (prod(x, y) != prod(y, x)) {
+            result.is_commutative = false;
+            break;
+          }
+        }
+      }
+
+      for (auto const& e : idempotents) {
+        size_t x = 0;
+        while (x < n && prod(e, x) == x && prod(x, e) == x) {
+          ++x;
+        }
+        if (x == n) {
+          result.is_monoid = true;
+          break;
+        }
+      }
+
+      // The principal right and left ideals xS ^ 1 and S ^ 1x
+      std::vector<Bitset> right(n, Bitset(n));
+      std::vector<Bitset> left(n, Bitset(n));
+      for (size_t x = 0; x < n; ++x) {
+        right[x].set(x);
+        left[x].set(x);
+        for (size_t s = 0; s < n; ++s) {
+          right[x].set(prod(x, s));
+          left[x].set(prod(s, x));
+        }
+      }
+
+      std::vector<Bitset> reps;
+      std::vector<size_t> r_index(n);
+      for (size_t x = 0; x < n; ++x) {
+        r_index[x] = class_index(reps, right[x]);
+      }
+      result.nr_r_classes = reps.size();
+
+      reps.clear();
+      std::vector<size_t> l_index(n);
+      for (size_t x = 0; x < n; ++x) {
+        l_index[x] = class_index(reps, left[x]);
+      }
+      result.nr_l_classes = reps.size();
+
+      Bitset h_classes(result.nr_r_classes * result.nr_l_classes);
+      for (size_t x = 0; x < n; ++x) {
+        h_classes.set(r_index[x] * result.nr_l_classes + l_index[x]);
+      }
+      result.nr_h_classes = h_classes.count();
+
+      // D = J since the semigroup is finite, and S ^ 1xS ^ 1 is the union of
+      // the right ideals yS ^ 1 for y in S ^ 1x.
+      reps.clear();
+      Bitset ideal(n);
+      for (size_t x = 0; x < n; ++x) {
+        ideal.reset();
+        for (size_t y = left[x].first(); y != Bitset::npos;
+             y        = left[x].next(y + 1)) {
+          ideal |= right[y];
+        }
+        class_index(reps, ideal);
+      }
+      result.nr_d_classes = reps.size();
+      result.is_simple    = (result.nr_d_classes == 1);
+
+      // A finite semigroup is regular if and only if every R-class contains
+      // an idempotent.
+      Bitset regular(result.nr_r_classes);
+      for (auto const& e : idempotents) {
+        regular.set(r_index[e]);
+      }
+      result.is_regular = (regular.count() == result.nr_r_classes);
+
+      if (result.is_regular) {
+        bool commute = true, central = true;
+        for (auto const& e : idempotents) {
+          for (size_t x = 0; x < n && central; ++x) {
+            if (prod(e, x) != prod(x, e)) {
+              central = false;
+            }
+          }
+          for (auto const& f : idempotents) {
+            if (prod(e, f) != prod(f, e)) {
+              commute = false;
+            }
+          }
+        }
+        result.is_inverse  = commute;
+        result.is_clifford = central;
+        result.is_group    = (idempotents.size() == 1);
+      }
+      return result;
+    }
+
+    Obj int_list(std::vector<Properties> const& props,
+                 uint32_t Properties::*member) {
+      Obj result = NEW_PLIST(props.empty() ? T_PLIST_EMPTY : T_PLIST_CYC,
+                             props.size());
+      SET_LEN_PLIST(result, props.size());
+      for (size_t i = 0; i < props.size(); ++i) {
+        SET_ELM_PLIST(result, i + 1, INTOBJ_INT(props[i].*member));
+      }
+      return result;
+    }
+
+    Obj bool_list(std::vector<Properties> const& props,
+                  bool Properties::*member) {
+      Obj result = NEW_PLIST(props.empty() ? T_PLIST_EMPTY : T_PLIST,
+                             props.size());
+      SET_LEN_PLIST(result, props.size());
+      for (size_t i = 0; i < props.size(); ++i) {
+        SET_ELM_PLIST(result, i + 1, props[i].*member ? True : False);
+      }
+      return result;
+    }
+  }  // namespace
+
+  Obj MULTIPLICATION_TABLES_PROPERTIES(Obj str, Obj nr_threads) {
+    if (!IS_STRING_REP(str)) {
+      ErrorQuit("expected a string, found %s", (Int) TNAM_OBJ(str), 0L);
+    }
+    size_t const n_threads = number_of_threads(nr_threads);
+    size_t const len       = GET_LEN_STRING(str);
+    auto const*  chars = reinterpret_cast<UInt1 const*>(CONST_CSTR_STRING(str));
+
+    // Check the tables before anything is allocated, so that nothing is
+    // leaked if there is an error.
+    size_t nr_tables = 0;
+    for (size_t pos = 0; pos < len;) {
+      auto const* last = static_cast<UInt1 const*>(
+          std::memchr(chars + pos, '\n', len - pos));
+      size_t const m = (last == nullptr ? len - pos : last - (chars + pos));
+      size_t const n = multiplication_table_degree(m);
+      if (n == 0) {
+        ErrorQuit("the file is corrupt, found an empty line", 0L, 0L);
+      }
+      for (size_t i = pos; i < pos + m; ++i) {
+        size_t const val = (chars[i] == 0 ? 10 : chars[i]);
+        if (val > n) {
+          ErrorQuit("the file is corrupt, found an entry %d in a table with "
+                    "%d rows",
+                    (Int) val,
+                    (Int) n);
+        }
+      }
+      nr_tables++;
+      pos += m + 1;
+    }
+
+    // Nothing below allocates GAP memory until the properties have been
+    // computed, and so <chars> stays valid.
+    std::vector<size_t>  offset;
+    std::vector<size_t>  degree;
+    std::vector<uint8_t> values;
+    offset.reserve(nr_tables);
+    degree.reserve(nr_tables);
+    values.reserve(len);
+    for (size_t pos = 0; pos < len;) {
+      auto const* last = static_cast<UInt1 const*>(
+          std::memchr(chars + pos, '\n', len - pos));
+      size_t const m = (last == nullptr ? len - pos : last - (chars + pos));
+      offset.push_back(values.size());
+      degree.push_back(multiplication_table_degree(m));
+      for (size_t i = pos; i < pos + m; ++i) {
+        values.push_back(chars[i] == 0 ? 9 : chars[i] - 1);
+      }
+      pos += m + 1;
+    }
+
+    std::vector<Properties> props(nr_tables);
+    size_t const            nr_chunks
+        = (nr_tables + TABLES_PER_CHUNK - 1) / TABLES_PER_CHUNK;
+    parallel_for(nr_chunks, n_threads, [&](size_t chunk) {
+      size_t const first = chunk * TABLES_PER_CHUNK;
+      size_t const last  = std::min(first + TABLES_PER_CHUNK, nr_tables);
+      for (size_t i = first; i < last; ++i) {
+        props[i] = properties(values.data() + offset[i], degree[i]);
+      }
+    });
+
+    Obj result = NEW_PREC(13);
+    AssPRec(result,
+            RNamName("NrIdempotents"),
+            int_list(props, &Properties::nr_idempotents));
+    AssPRec(result,
+            RNamName("NrRClasses"),
+            int_list(props, &Properties::nr_r_classes));
+    AssPRec(result,
+            RNamName("NrLClasses"),
+            int_list(props, &Properties::nr_l_classes));
+    AssPRec(result,
+            RNamName("NrHClasses"),
+            int_list(props, &Properties::nr_h_classes));
+    AssPRec(result,
+            RNamName("NrDClasses"),
+            int_list(props, &Properties::nr_d_classes));
+    AssPRec(result, RNamName("IsBand"), bool_list(props, &Properties::is_band));
+    AssPRec(result,
+            RNamName("IsCommutativeSemigroup"),
+            bool_list(props, &Properties::is_commutative));
+    AssPRec(result,
+            RNamName("IsMonoidAsSemigroup"),
+            bool_list(props, &Properties::is_monoid));
+    AssPRec(result,
+            RNamName("IsRegularSemigroup"),
+            bool_list(props, &Properties::is_regular));
+    AssPRec(result,
+            RNamName("IsInverseSemigroup"),
+            bool_list(props, &Properties::is_inverse));
+    AssPRec(result,
+            RNamName("IsCliffordSemigroup"),
+            bool_list(props, &Properties::is_clifford));
+    AssPRec(result,
+            RNamName("IsGroupAsSemigroup"),
+            bool_list(props, &Properties::is_group));
+    AssPRec(result,
+            RNamName("IsSimpleSemigroup"),
+            bool_list(props, &Properties::is_simple));
+    return result;
+  }
+}  // namespace semigroups
@@ -0,0 +1,37 @@
+//
+// Semigroups package for GAP
+// Copyright (C) 2025 James D. Mitchell
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+
+// This file contains declarations of functions for computing properties of
+// many small semigroups, given by their multiplication tables, at once.
+
+#ifndef SEMIGROUPS_SRC_MULT_TABLE_PROPS_HPP_
+#define SEMIGROUPS_SRC_MULT_TABLE_PROPS_HPP_
+
+#include "compiled.h"  // for Obj
+
+namespace semigroups {
+  // Returns a record whose components are lists with one entry for every
+  // multiplication table encoded in the lines of the GAP string <str>, in the
+  // format described in mult-table-file.hpp. The i-th entry of each list is
+  // the value of the corresponding property (NrIdempotents, IsBand, etc) of
+  // the semigroup with the i-th multiplication table. The tables are not
+  // checked to be associative.
+  Obj MULTIPLICATION_TABLES_PROPERTIES(Obj str, Obj nr_threads);
+}  // namespace semigroups
+
+#endif  // SEMIGROUPS_SRC_MULT_TABLE_PROPS_HPP_
@@ -0,0 +1,83 @@
+//
+// Semigroups package for GAP
+// Copyright (C) 2022 James D. Mitchell
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+
+// This file contains some helper functions for the kernel functions that
+// distribute their work over a number of threads.
+
+#ifndef SEMIGROUPS_SRC_PARALLEL_HPP_
+#define SEMIGROUPS_SRC_PARALLEL_HPP_
+
+#include <algorithm>  // for min, max
+#include <atomic>     // for atomic
+#include <cstddef>    // for size_t
+#include <thread>     // for thread
+#include <vector>     // for vector
+
+// GAP headers
+#include "compiled.h"  // for Obj, ErrorQuit
+
+namespace semigroups {
+
+  // Returns <nr_threads> capped at the number of hardware threads, and at
+  // least 1.
+  inline size_t number_of_threads(size_t nr_threads) {
+    return std::max(
+        size_t(1),
+        std::min(nr_threads,
+                 static_cast<size_t>(std::thread::hardware_concurrency())));
+  }
+
+  // Returns the value of the GAP integer <nr_threads> capped at the number of
+  // hardware threads, or throws a GAP error if <nr_threads> is not a
+  // positive integer.
+  inline size_t number_of_threads(Obj nr_threads) {
+    if (!IS_INTOBJ(nr_threads) || INT_INTOBJ(nr_threads) <= 0) {
+      ErrorQuit("expected a positive integer, found %s",
+                (Int) TNAM_OBJ(nr_threads),
+                0L);
+    }
+    return number_of_threads(static_cast<size_t>(INT_INTOBJ(nr_threads)));
+  }
+
+  // Runs f(k) for k in [0, n) using nr_threads threads.
+  template <typename Func>
+  void parallel_for(size_t n, size_t nr_threads, Func&& f) {
+    nr_threads = std::min(nr_threads, n);
+    if (nr_threads <= 1) {
+      for (size_t k = 0; k < n; ++k) {
+        f(k);
+      }
+      return;
+    }
+    std::atomic<size_t>      next(0);
+    std::vector<std::thread> threads;
+    for (size_t t = 0; t < nr_threads; ++t) {
+      threads.emplace_back([&next, &f, n]() {
+        for (size_t k = next++; k < n; k = next++) {
+          f(k);
+        }
+      });
+    }
+    for (auto& thread : threads) {
+      thread.join();
+    }
+  }
+
+}  // namespace semigroups
+
+#endif  // SEMIGROUPS_SRC_PARALLEL_HPP_
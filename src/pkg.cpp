@@ -25,6 +25,8 @@
 #include <cstddef>        // for size_t
 #include <exception>      // for exception
 #include <iostream>       // for string
+#include <stdexcept>      // for runtime_error
+#include <string>         // for string, to_string
 #include <type_traits>    // for conditional<>::type
 #include <unordered_map>  // for unordered_map
 #include <utility>        // for swap
@@ -39,11 +41,22 @@
 #include "bipart.hpp"  // for Blocks, Bipartition
 #include "cong.hpp"    // for init_cong
 #include "conglatt.hpp"
+#include "freeband.hpp"  // for init_freeband
 #include "froidure-pin-fallback.hpp"  // for RUN_FROIDURE_PIN
+#include "froidure-pin-file.hpp"      // for init_froidure_pin_file
 #include "froidure-pin.hpp"           // for init_froidure_pin
+#include "generators-file.hpp"        // for init_generators_file
+#include "greens.hpp"                 // for PARTIAL_ORDER_OF_DCLASSES
+#include "idempotents.hpp"            // for TRANS_NR_IDEMPOTENTS etc
+#include "isomorph.hpp"               // for ON_MULTIPLICATION_TABLE etc
+#include "mult-table-file.hpp"        // for DECODE_MULTIPLICATION_TABLES
+#include "mult-table-props.hpp"       // for MULTIPLICATION_TABLES_PROPERTIES
 #include "semigroups-debug.hpp"       // for SEMIGROUPS_ASSERT
+#include "sims1.hpp"                  // for init_sims1
+#include "tietze.hpp"                 // for STZ_SIMPLIFY_PRESENTATION
 #include "to_cpp.hpp"                 // for to_cpp
 #include "to_gap.hpp"                 // for to_gap
+#include "translat.hpp"               // for LEFT_TRANSLATIONS_BACKTRACK etc
 
 // Gapbind14 headers
 #include "gapbind14/cpp_fn.hpp"     // for overload_cast
@@ -56,7 +69,7 @@
 #include "libsemigroups/fpsemi.hpp"     // for FpSemigroup
 #include "libsemigroups/freeband.hpp"   // for freeband_equal_to
 #include "libsemigroups/report.hpp"     // for REPORTER, Reporter
-#include "libsemigroups/sims1.hpp"      // for Sims1
+#include "libsemigroups/sims1.hpp"      // for RepOrc
 #include "libsemigroups/todd-coxeter.hpp"  // for ToddCoxeter, ToddCoxeter::table_type
 #include "libsemigroups/types.hpp"         // for word_type, letter_type
 
@@ -73,20 +86,49 @@ namespace {
   void set_report(bool const val) {
     libsemigroups::REPORTER.report(val);
   }
+
+  // Returns the table for ToddCoxeter::prefill of the Cayley graph <graph>,
+  // which must be a plain list of plain lists of positive integers, such as
+  // the components "right" and "left" of a GapFroidurePin. This reads every
+  // entry of <graph> once, and so avoids creating the GAP list <graph> - 1,
+  // and the second pass of to_cpp<DynamicArray2>.
+  libsemigroups::congruence::ToddCoxeter::table_type
+  cayley_graph_to_table(Obj graph) {
+    using table_type = libsemigroups::congruence::ToddCoxeter::table_type;
+    using value_type = table_type::value_type;
+    if (!IS_PLIST(graph)) {
+      throw std::runtime_error("expected a plain list, found "
+                               + std::string(TNAM_OBJ(graph)));
+    }
+    size_t const nr_rows = LEN_PLIST(graph);
+    size_t const nr_cols
+        = (nr_rows == 0 || !IS_PLIST(ELM_PLIST(graph, 1))
+               ? 0
+               : LEN_PLIST(ELM_PLIST(graph, 1)));
+    table_type result(nr_cols, nr_rows);
+    for (size_t i = 0; i < nr_rows; ++i) {
+      Obj row = ELM_PLIST(graph, i + 1);
+      if (!IS_PLIST(row) || static_cast<size_t>(LEN_PLIST(row)) != nr_cols) {
+        throw std::runtime_error("expected a plain list of length "
+                                 + std::to_string(nr_cols) + " in position "
+                                 + std::to_string(i + 1));
+      }
+      for (size_t j = 0; j < nr_cols; ++j) {
+        Obj x = ELM_PLIST(row, j + 1);
+        if (!IS_INTOBJ(x) || INT_INTOBJ(x) < 1
+            || static_cast<size_t>(INT_INTOBJ(x)) > nr_rows) {
+          throw std::runtime_error("expected integers in the range [1, "
+                                   + std::to_string(nr_rows) + "] in row "
+                                   + std::to_string(i + 1));
+        }
+        result.set(i, j, static_cast<value_type>(INT_INTOBJ(x) - 1));
+      }
+    }
+    return result;
+  }
 }  // namespace
 
 namespace gapbind14 {
-  template <>
-  struct IsGapBind14Type<libsemigroups::Presentation<libsemigroups::word_type>>
-      : std::true_type {};
-
-  template <>
-  struct IsGapBind14Type<libsemigroups::Sims1<uint32_t>> : std::true_type {};
-
-  template <>
-  struct IsGapBind14Type<typename libsemigroups::Sims1<uint32_t>::iterator>
-      : std::true_type {};
-
   template <>
   struct IsGapBind14Type<libsemigroups::RepOrc> : std::true_type {};
 }  // namespace gapbind14
@@ -109,6 +151,35 @@ GAPBIND14_MODULE(libsemigroups) {
 
   gapbind14::InstallGlobalFunction("LATTICE_OF_CONGRUENCES",
                                    &semigroups::LATTICE_OF_CONGRUENCES);
+  gapbind14::InstallGlobalFunction("PRINCIPAL_CONGRUENCES",
+                                   &semigroups::PRINCIPAL_CONGRUENCES);
+  gapbind14::InstallGlobalFunction("ALL_PRINCIPAL_CONGRUENCES",
+                                   &semigroups::ALL_PRINCIPAL_CONGRUENCES);
+  gapbind14::InstallGlobalFunction("POSET_OF_CONGRUENCES",
+                                   &semigroups::POSET_OF_CONGRUENCES);
+  gapbind14::InstallGlobalFunction("PARTIAL_ORDER_OF_DCLASSES",
+                                   &semigroups::PARTIAL_ORDER_OF_DCLASSES);
+  gapbind14::InstallGlobalFunction("TRANS_NR_IDEMPOTENTS",
+                                   &semigroups::TRANS_NR_IDEMPOTENTS);
+  gapbind14::InstallGlobalFunction("PPERM_NR_IDEMPOTENTS",
+                                   &semigroups::PPERM_NR_IDEMPOTENTS);
+  gapbind14::InstallGlobalFunction("WRITE_GENERATORS_FILE",
+                                   &semigroups::WRITE_GENERATORS_FILE);
+  gapbind14::InstallGlobalFunction("IS_GENERATORS_FILE",
+                                   &semigroups::IS_GENERATORS_FILE);
+  gapbind14::InstallGlobalFunction("DECODE_MULTIPLICATION_TABLES",
+                                   &semigroups::DECODE_MULTIPLICATION_TABLES);
+  gapbind14::InstallGlobalFunction("ENCODE_MULTIPLICATION_TABLES",
+                                   &semigroups::ENCODE_MULTIPLICATION_TABLES);
+  gapbind14::InstallGlobalFunction(
+      "MULTIPLICATION_TABLES_PROPERTIES",
+      &semigroups::MULTIPLICATION_TABLES_PROPERTIES);
+  gapbind14::InstallGlobalFunction("LEFT_TRANSLATIONS_BACKTRACK",
+                                   &semigroups::LEFT_TRANSLATIONS_BACKTRACK);
+  gapbind14::InstallGlobalFunction("RIGHT_TRANSLATIONS_BACKTRACK",
+                                   &semigroups::RIGHT_TRANSLATIONS_BACKTRACK);
+  gapbind14::InstallGlobalFunction("BITRANSLATIONS_BACKTRACK",
+                                   &semigroups::BITRANSLATIONS_BACKTRACK);
 
   ////////////////////////////////////////////////////////////////////////
   // Initialise from other cpp files
@@ -123,7 +194,12 @@ GAPBIND14_MODULE(libsemigroups) {
   init_froidure_pin_pperm(gapbind14::module());
   init_froidure_pin_pbr(gapbind14::module());
   init_froidure_pin_transf(gapbind14::module());
+  init_froidure_pin_file(gapbind14::module());
+  init_generators_file(gapbind14::module());
   init_cong(gapbind14::module());
+  init_conglatt(gapbind14::module());
+  init_freeband(gapbind14::module());
+  init_sims1(gapbind14::module());
 
   ////////////////////////////////////////////////////////////////////////
   // FpSemigroup
@@ -156,7 +232,10 @@ GAPBIND14_MODULE(libsemigroups) {
       .def("set_number_of_generators", &ToddCoxeter::set_number_of_generators)
       .def("number_of_generators", &ToddCoxeter::number_of_generators)
       .def("prefill",
-           gapbind14::overload_cast<table_type const&>(&ToddCoxeter::prefill));
+           gapbind14::overload_cast<table_type const&>(&ToddCoxeter::prefill))
+      .def("prefill_from_cayley_graph", [](ToddCoxeter& tc, Obj graph) {
+        tc.prefill(cayley_graph_to_table(graph));
+      });
 
   using libsemigroups::Presentation;
 
@@ -189,27 +268,19 @@ GAPBIND14_MODULE(libsemigroups) {
                                word_type const&>(
           &libsemigroups::presentation::add_rule<word_type>));
 
-  using libsemigroups::Sims1;
-
-  gapbind14::class_<typename Sims1<uint32_t>::iterator>("Sims1Iterator")
-      .def("increment", [](typename Sims1<uint32_t>::iterator& it) { ++it; })
-      .def("deref",
-           [](typename Sims1<uint32_t>::iterator const& it) { return *it; });
-
-  gapbind14::class_<Sims1<uint32_t>>("Sims1")
-      .def(gapbind14::init<congruence_kind>{}, "make")
-      .def("short_rules",
-           [](Sims1<uint32_t>& s, Presentation<word_type> const& p) {
-             s.short_rules(p);
-           })
-      .def("extra",
-           [](Sims1<uint32_t>& s, Presentation<word_type> const& p) {
-             s.extra(p);
-           })
-      .def("number_of_threads",
-           [](Sims1<uint32_t>& s, size_t val) { s.number_of_threads(val); })
-      .def("number_of_congruences", &Sims1<uint32_t>::number_of_congruences)
-      .def("cbegin", &Sims1<uint32_t>::cbegin);
+  gapbind14::InstallGlobalFunction("STZ_SIMPLIFY_PRESENTATION",
+                                   &semigroups::STZ_SIMPLIFY_PRESENTATION);
+  gapbind14::InstallGlobalFunction(
+      "CANONICAL_DIGRAPH_OUT_NEIGHBOURS",
+      &semigroups::CANONICAL_DIGRAPH_OUT_NEIGHBOURS);
+  gapbind14::InstallGlobalFunction("ON_MULTIPLICATION_TABLE",
+                                   &semigroups::ON_MULTIPLICATION_TABLE);
+  gapbind14::InstallGlobalFunction(
+      "MULTIPLICATION_TABLE_INVARIANT",
+      &semigroups::MULTIPLICATION_TABLE_INVARIANT);
+  gapbind14::InstallGlobalFunction(
+      "SMALLEST_MULTIPLICATION_TABLE",
+      &semigroups::SMALLEST_MULTIPLICATION_TABLE);
 
   using libsemigroups::RepOrc;
 
@@ -220,7 +291,11 @@ GAPBIND14_MODULE(libsemigroups) {
              ro.short_rules(p);
            })
       .def("number_of_threads",
-           [](RepOrc& ro, size_t val) { ro.number_of_threads(val); })
+           [](RepOrc& ro, size_t val) {
+             ro.number_of_threads(std::max(
+                 size_t(1),
+                 std::min(val, size_t(std::thread::hardware_concurrency()))));
+           })
       .def("max_nodes", [](RepOrc& ro, size_t val) { ro.max_nodes(val); })
       .def("min_nodes", [](RepOrc& ro, size_t val) { ro.min_nodes(val); })
       .def("target_size", [](RepOrc& ro, size_t val) { ro.target_size(val); })
@@ -265,6 +340,7 @@ void TBipartObjFreeFunc(Obj o) {
 
 void TBlocksObjFreeFunc(Obj o) {
   SEMIGROUPS_ASSERT(TNUM_OBJ(o) == T_BLOCKS);
+  blocks_forget(o);
   delete blocks_get_cpp(o);
 }
 
@@ -316,6 +392,7 @@ void TBlocksObjLoadFunc(Obj o) {
   UInt4 deg = LoadUInt4();
   if (deg == 0) {
     ADDR_OBJ(o)[0] = reinterpret_cast<Obj>(new Blocks());
+    blocks_remember(o);
     return;
   }
   UInt4 nr_blocks = LoadUInt4();
@@ -332,6 +409,7 @@ void TBlocksObjLoadFunc(Obj o) {
   libsemigroups::validate(*blocks);
 #endif
   ADDR_OBJ(o)[0] = reinterpret_cast<Obj>(blocks);
+  blocks_remember(o);
 }
 
 #endif
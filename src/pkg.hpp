@@ -33,6 +33,8 @@
 
 #include "gapbind14/gapbind14.hpp"
 
+#include "libsemigroups/types.hpp"  // for word_type
+
 extern UInt T_BIPART;
 extern UInt T_BLOCKS;
 
@@ -77,6 +79,8 @@ extern Obj Matrix;
 
 namespace libsemigroups {
   class FpSemigroup;
+  template <typename Word>
+  class Presentation;
   namespace congruence {
     class ToddCoxeter;
   }
@@ -90,6 +94,10 @@ namespace gapbind14 {
   struct IsGapBind14Type<libsemigroups::congruence::ToddCoxeter>
       : std::true_type {};
 
+  template <>
+  struct IsGapBind14Type<libsemigroups::Presentation<libsemigroups::word_type>>
+      : std::true_type {};
+
 }  // namespace gapbind14
 
 #endif  // SEMIGROUPS_SRC_PKG_HPP_
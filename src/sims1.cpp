@@ -0,0 +1,491 @@
+//
+// Semigroups package for GAP
+// Copyright (C) 2022 James D. Mitchell
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+
+// This file contains the bindings for libsemigroups::Sims1, a class
+// Sims1Counter for counting congruences, possibly in a background thread, so
+// that the number found so far can be sampled from GAP, and a class Sims1Queue
+// for finding word graphs in a background thread.
+
+#include "sims1.hpp"
+
+#include <algorithm>           // for min
+#include <atomic>              // for atomic
+#include <chrono>              // for seconds
+#include <condition_variable>  // for condition_variable
+#include <cstddef>             // for size_t
+#include <cstdint>             // for uint32_t, uint64_t
+#include <deque>               // for deque
+#include <exception>           // for exception_ptr
+#include <iostream>            // for cout
+#include <memory>              // for unique_ptr
+#include <mutex>               // for mutex, unique_lock
+#include <thread>              // for thread
+#include <type_traits>         // for true_type
+#include <vector>              // for vector
+
+// GAP headers
+#include "compiled.h"  // for Obj
+
+// Semigroups GAP package headers
+#include "pkg.hpp"  // for IsGapBind14Type
+
+// GapBind14 headers
+#include "gapbind14/gapbind14.hpp"  // for class_
+
+// libsemigroups headers
+#include "libsemigroups/cong-intf.hpp"  // for congruence_kind
+#include "libsemigroups/constants.hpp"  // for UNDEFINED
+#include "libsemigroups/digraph.hpp"    // for ActionDigraph
+#include "libsemigroups/present.hpp"    // for Presentation
+#include "libsemigroups/report.hpp"     // for should_report
+#include "libsemigroups/sims1.hpp"      // for Sims1
+#include "libsemigroups/string.hpp"     // for group_digits
+#include "libsemigroups/types.hpp"      // for word_type
+
+namespace semigroups {
+
+  namespace {
+    using digraph_type = typename libsemigroups::Sims1<uint32_t>::digraph_type;
+
+    // Returns the number of active nodes in the word graph d, i.e. those nodes
+    // with at least one defined out-neighbour, these always form an initial
+    // segment of the nodes, and the out-neighbours of the other nodes are all
+    // undefined.
+    size_t number_of_active_nodes(digraph_type const& d) {
+      using libsemigroups::UNDEFINED;
+      size_t n = 0;
+      while (n < d.number_of_nodes() && d.out_degree() != 0
+             && d.unsafe_neighbor(n, 0) != UNDEFINED) {
+        ++n;
+      }
+      return n;
+    }
+
+    // Returns the out-neighbours of the active nodes of the word graph d.
+    Obj word_graph_to_gap(digraph_type const& d) {
+      size_t const m = d.out_degree();
+      size_t const n = number_of_active_nodes(d);
+
+      Obj result = NEW_PLIST(T_PLIST, n);
+      SET_LEN_PLIST(result, n);
+      for (size_t i = 0; i < n; ++i) {
+        Obj next = NEW_PLIST(T_PLIST_CYC, m);
+        SET_LEN_PLIST(next, m);
+        for (size_t j = 0; j < m; ++j) {
+          SET_ELM_PLIST(next, j + 1, INTOBJ_INT(d.unsafe_neighbor(i, j) + 1));
+        }
+        SET_ELM_PLIST(result, i + 1, next);
+        CHANGED_BAG(result);
+      }
+      return result;
+    }
+  }  // namespace
+
+  // A Sims1Counter counts the congruences found by (a copy of) a
+  // libsemigroups::Sims1 object, optionally stopping once a given number of
+  // congruences has been found. The search can be run in a background thread,
+  // in which case the number of congruences found so far can be read from GAP
+  // at any time using "count".
+  class Sims1Counter {
+   public:
+    using sims1_type = libsemigroups::Sims1<uint32_t>;
+
+    Sims1Counter()
+        : _count(0),
+          _cv(),
+          _exception(),
+          _finished(true),
+          _limit(0),
+          _mtx(),
+          _n(0),
+          _sims1(),
+          _stop(false),
+          _thread() {}
+
+    Sims1Counter(Sims1Counter const&)            = delete;
+    Sims1Counter(Sims1Counter&&)                 = delete;
+    Sims1Counter& operator=(Sims1Counter const&) = delete;
+    Sims1Counter& operator=(Sims1Counter&&)      = delete;
+
+    ~Sims1Counter() {
+      stop();
+    }
+
+    // Count the congruences with at most n classes, stopping once limit have
+    // been found, or counting all of them if limit is 0.
+    void init(sims1_type const& s, size_t n, uint64_t limit) {
+      stop();
+      _sims1     = std::make_unique<sims1_type>(s);
+      _n         = n;
+      _limit     = limit;
+      _count     = 0;
+      _exception = nullptr;
+      _finished  = false;
+      _stop      = false;
+    }
+
+    // Start the search in a background thread, and return immediately.
+    void start() {
+      if (_sims1 == nullptr || _thread.joinable() || _finished) {
+        return;
+      }
+      _thread = std::thread(&Sims1Counter::search, this);
+    }
+
+    // Wait for the search to finish, reporting progress (if reporting is
+    // enabled) once a second, and return the number of congruences found.
+    uint64_t wait() {
+      using std::chrono::duration_cast;
+      using std::chrono::seconds;
+      using libsemigroups::detail::group_digits;
+
+      if (!_thread.joinable()) {
+        return count();
+      }
+      auto     start_time  = std::chrono::high_resolution_clock::now();
+      auto     last_report = start_time;
+      uint64_t last_count  = count();
+      bool     report      = libsemigroups::report::should_report();
+
+      std::unique_lock<std::mutex> lock(_mtx);
+      while (!_cv.wait_for(
+          lock, std::chrono::seconds(1), [this]() { return _finished; })) {
+        if (report) {
+          auto     now        = std::chrono::high_resolution_clock::now();
+          auto     total_time = duration_cast<seconds>(now - start_time);
+          auto     diff_time  = duration_cast<seconds>(now - last_report);
+          uint64_t this_count = count();
+          std::cout << "#I  Sims1: found " << group_digits(this_count)
+                    << " congruences in " << total_time.count() << "s ("
+                    << group_digits((this_count - last_count)
+                                    / std::max(diff_time.count(),
+                                               decltype(diff_time.count())(1)))
+                    << "/s)!\n";
+          last_report = now;
+          last_count  = this_count;
+        }
+      }
+      lock.unlock();
+      _thread.join();
+      if (_exception != nullptr) {
+        std::rethrow_exception(_exception);
+      }
+      return count();
+    }
+
+    // Run the search to completion in the background thread, and return the
+    // number of congruences found.
+    uint64_t run() {
+      start();
+      return wait();
+    }
+
+    // Ask the search to stop, and wait for it to do so. The search can only
+    // stop when it finds another congruence, so this may not be immediate.
+    void stop() {
+      _stop = true;
+      if (_thread.joinable()) {
+        _thread.join();
+      }
+    }
+
+    // The number of congruences found so far, this can be called while the
+    // search is running.
+    uint64_t count() const noexcept {
+      uint64_t result = _count;
+      return _limit == 0 ? result : std::min(result, _limit);
+    }
+
+    bool finished() const {
+      std::lock_guard<std::mutex> lock(_mtx);
+      return _finished;
+    }
+
+   private:
+    void search() {
+      try {
+        // The predicate is called from every thread used by _sims1, and so
+        // only touches atomics.
+        _sims1->find_if(_n, [this](digraph_type const&) {
+          uint64_t const c = ++_count;
+          return _stop || (_limit != 0 && c >= _limit);
+        });
+      } catch (...) {
+        _exception = std::current_exception();
+      }
+      {
+        std::lock_guard<std::mutex> lock(_mtx);
+        _finished = true;
+      }
+      _cv.notify_all();
+    }
+
+    std::atomic<uint64_t>       _count;
+    std::condition_variable     _cv;
+    std::exception_ptr          _exception;
+    bool                        _finished;
+    uint64_t                    _limit;
+    mutable std::mutex          _mtx;
+    size_t                      _n;
+    std::unique_ptr<sims1_type> _sims1;
+    std::atomic<bool>           _stop;
+    std::thread                 _thread;
+  };
+
+  // A Sims1Queue runs a libsemigroups::Sims1 iterator in a background thread,
+  // and stores the word graphs it finds in a queue of bounded capacity, so
+  // that the search can proceed while GAP processes the word graphs already
+  // found. The word graphs are stored compactly as the out-neighbours of the
+  // active nodes, concatenated, and are returned to GAP in chunks, as lists of
+  // the out-neighbours of the nodes, i.e. the argument of DigraphNC.
+  class Sims1Queue {
+   public:
+    using sims1_type = libsemigroups::Sims1<uint32_t>;
+
+    Sims1Queue()
+        : _capacity(0),
+          _exception(),
+          _finished(true),
+          _mtx(),
+          _not_empty(),
+          _not_full(),
+          _out_degree(0),
+          _queue(),
+          _sims1(),
+          _stop(false),
+          _thread() {}
+
+    Sims1Queue(Sims1Queue const&)            = delete;
+    Sims1Queue(Sims1Queue&&)                 = delete;
+    Sims1Queue& operator=(Sims1Queue const&) = delete;
+    Sims1Queue& operator=(Sims1Queue&&)      = delete;
+
+    ~Sims1Queue() {
+      stop();
+    }
+
+    // Start a background search for the word graphs with at most n nodes,
+    // storing at most capacity word graphs that have not yet been retrieved.
+    void init(sims1_type const& s, size_t n, size_t capacity) {
+      stop();
+      _sims1      = std::make_unique<sims1_type>(s);
+      _capacity   = std::max(capacity, size_t(1));
+      _exception  = nullptr;
+      _finished   = false;
+      _out_degree = _sims1->short_rules().alphabet().size();
+      _queue.clear();
+      _stop   = false;
+      _thread = std::thread(&Sims1Queue::search, this, n);
+    }
+
+    size_t out_degree() const noexcept {
+      return _out_degree;
+    }
+
+    // Returns a list of (at most) the next k word graphs, each a list of the
+    // out-neighbours of its nodes. This blocks until at
+    // least one word graph is available, or the search is finished, and so an
+    // empty list indicates that there are no more word graphs.
+    Obj next_k(size_t k) {
+      std::vector<std::vector<uint32_t>> chunk;
+      {
+        std::unique_lock<std::mutex> lock(_mtx);
+        _not_empty.wait(lock,
+                        [this]() { return !_queue.empty() || _finished; });
+        while (chunk.size() < k && !_queue.empty()) {
+          chunk.push_back(std::move(_queue.front()));
+          _queue.pop_front();
+        }
+        if (chunk.empty() && _exception != nullptr) {
+          std::rethrow_exception(_exception);
+        }
+      }
+      _not_full.notify_one();
+
+      size_t const m      = _out_degree;
+      Obj          result = NEW_PLIST(T_PLIST, chunk.size());
+      SET_LEN_PLIST(result, chunk.size());
+      for (size_t i = 0; i < chunk.size(); ++i) {
+        auto const&  flat = chunk[i];
+        size_t const n    = (m == 0 ? 0 : flat.size() / m);
+        Obj          next = NEW_PLIST(T_PLIST, n);
+        SET_LEN_PLIST(next, n);
+        for (size_t v = 0; v < n; ++v) {
+          Obj nbs = NEW_PLIST(T_PLIST_CYC, m);
+          SET_LEN_PLIST(nbs, m);
+          for (size_t j = 0; j < m; ++j) {
+            SET_ELM_PLIST(nbs, j + 1, INTOBJ_INT(flat[v * m + j] + 1));
+          }
+          SET_ELM_PLIST(next, v + 1, nbs);
+          CHANGED_BAG(next);
+        }
+        SET_ELM_PLIST(result, i + 1, next);
+        CHANGED_BAG(result);
+      }
+      return result;
+    }
+
+    // Stop the search, the background thread can only notice this between
+    // word graphs, and so this may not be immediate.
+    void stop() {
+      {
+        std::lock_guard<std::mutex> lock(_mtx);
+        _stop = true;
+      }
+      _not_full.notify_one();
+      if (_thread.joinable()) {
+        _thread.join();
+      }
+    }
+
+   private:
+    void search(size_t n) {
+      try {
+        auto it = _sims1->cbegin(n);
+        while (true) {
+          auto const&  d = *it;
+          size_t const m = number_of_active_nodes(d);
+          if (m == 0) {
+            break;
+          }
+          std::vector<uint32_t> flat;
+          flat.reserve(m * _out_degree);
+          for (size_t i = 0; i < m; ++i) {
+            for (size_t j = 0; j < _out_degree; ++j) {
+              flat.push_back(d.unsafe_neighbor(i, j));
+            }
+          }
+          {
+            std::unique_lock<std::mutex> lock(_mtx);
+            _not_full.wait(
+                lock, [this]() { return _queue.size() < _capacity || _stop; });
+            if (_stop) {
+              break;
+            }
+            _queue.push_back(std::move(flat));
+          }
+          _not_empty.notify_one();
+          ++it;
+        }
+      } catch (...) {
+        std::lock_guard<std::mutex> lock(_mtx);
+        _exception = std::current_exception();
+      }
+      {
+        std::lock_guard<std::mutex> lock(_mtx);
+        _finished = true;
+      }
+      _not_empty.notify_one();
+    }
+
+    size_t                            _capacity;
+    std::exception_ptr                _exception;
+    bool                              _finished;
+    std::mutex                        _mtx;
+    std::condition_variable           _not_empty;
+    std::condition_variable           _not_full;
+    size_t                            _out_degree;
+    std::deque<std::vector<uint32_t>> _queue;
+    std::unique_ptr<sims1_type>       _sims1;
+    bool                              _stop;
+    std::thread                       _thread;
+  };
+}  // namespace semigroups
+
+namespace gapbind14 {
+  template <>
+  struct IsGapBind14Type<libsemigroups::Sims1<uint32_t>> : std::true_type {};
+
+  template <>
+  struct IsGapBind14Type<typename libsemigroups::Sims1<uint32_t>::iterator>
+      : std::true_type {};
+
+  template <>
+  struct IsGapBind14Type<semigroups::Sims1Counter> : std::true_type {};
+
+  template <>
+  struct IsGapBind14Type<semigroups::Sims1Queue> : std::true_type {};
+}  // namespace gapbind14
+
+void init_sims1(gapbind14::Module& m) {
+  using libsemigroups::congruence_kind;
+  using libsemigroups::Presentation;
+  using libsemigroups::Sims1;
+  using libsemigroups::word_type;
+  using semigroups::Sims1Counter;
+  using semigroups::Sims1Queue;
+
+  gapbind14::class_<typename Sims1<uint32_t>::iterator>("Sims1Iterator")
+      .def("increment", [](typename Sims1<uint32_t>::iterator& it) { ++it; })
+      .def("deref",
+           [](typename Sims1<uint32_t>::iterator const& it) { return *it; })
+      // Returns a list of (at most) the next k word graphs, with the inactive
+      // nodes removed, and advances the iterator past them. An empty list
+      // indicates that the iterator is exhausted.
+      .def("next_k", [](typename Sims1<uint32_t>::iterator& it, size_t k) {
+        Obj result = NEW_PLIST(T_PLIST, k);
+        for (size_t i = 0; i < k && (*it).number_of_nodes() != 0; ++i, ++it) {
+          PushPlist(result, semigroups::word_graph_to_gap(*it));
+        }
+        return result;
+      });
+
+  gapbind14::class_<Sims1<uint32_t>>("Sims1")
+      .def(gapbind14::init<congruence_kind>{}, "make")
+      .def("short_rules",
+           [](Sims1<uint32_t>& s, Presentation<word_type> const& p) {
+             s.short_rules(p);
+           })
+      .def("extra",
+           [](Sims1<uint32_t>& s, Presentation<word_type> const& p) {
+             s.extra(p);
+           })
+      .def("number_of_threads",
+           [](Sims1<uint32_t>& s, size_t val) {
+             s.number_of_threads(std::max(
+                 size_t(1),
+                 std::min(val, size_t(std::thread::hardware_concurrency()))));
+           })
+      .def("number_of_congruences", &Sims1<uint32_t>::number_of_congruences)
+      .def("cbegin", &Sims1<uint32_t>::cbegin);
+
+  gapbind14::class_<Sims1Counter>("Sims1Counter")
+      .def(gapbind14::init<>{}, "make")
+      .def("init",
+           [](Sims1Counter&          c,
+              Sims1<uint32_t> const& s,
+              size_t                 n,
+              size_t                 limit) { c.init(s, n, limit); })
+      .def("start", &Sims1Counter::start)
+      .def("wait", &Sims1Counter::wait)
+      .def("run", &Sims1Counter::run)
+      .def("stop", &Sims1Counter::stop)
+      .def("count", &Sims1Counter::count)
+      .def("finished", &Sims1Counter::finished);
+
+  gapbind14::class_<Sims1Queue>("Sims1Queue")
+      .def(gapbind14::init<>{}, "make")
+      .def("init",
+           [](Sims1Queue&            q,
+              Sims1<uint32_t> const& s,
+              size_t                 n,
+              size_t                 capacity) { q.init(s, n, capacity); })
+      .def("out_degree", &Sims1Queue::out_degree)
+      .def("next_k", &Sims1Queue::next_k)
+      .def("stop", &Sims1Queue::stop);
+}
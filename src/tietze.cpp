@@ -0,0 +1,852 @@
+//
+// Semigroups package for GAP
+// Copyright (C) 2025 James D. Mitchell
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+
+// This file contains an implementation, in C++, of the strategy used by
+// StzSimplifyOnce (see gap/fp/tietze.gi) to simplify a presentation of a
+// semigroup. At every step the length of the presentation obtained by each of
+// the following transformations is computed, and the transformation giving
+// the shortest presentation is applied:
+//
+//   1. removing a generator a using a relation a = w where a is not in w;
+//   2. removing a relation that is a duplicate of another relation;
+//   3. replacing the longer side of a relation by the shorter side in all
+//      of the other relations;
+//   4. introducing a new generator equal to a frequently occurring subword;
+//   5. removing a relation of the form w = w.
+//
+// Ties are broken in the same way as in StzSimplifyOnce, and so the result is
+// the same as that of calling StzSimplifyOnce until it returns false. The
+// numbers of occurrences of subwords of the relations, required by 3 and 4,
+// are obtained from a suffix automaton of the relations, rather than by
+// searching the relations for every subword of every relation.
+
+#include "tietze.hpp"
+
+#include <algorithm>  // for count, equal, find, search, sort, swap
+#include <cstddef>    // for size_t
+#include <cstdint>    // for int64_t
+#include <limits>     // for numeric_limits
+#include <map>        // for map
+#include <stdexcept>  // for runtime_error
+#include <string>     // for to_string
+#include <utility>    // for pair, move
+#include <vector>     // for vector
+
+// GAP headers
+#include "compiled.h"
+
+// libsemigroups headers
+#include "libsemigroups/present.hpp"  // for Presentation
+#include "libsemigroups/types.hpp"    // for word_type, letter_type
+
+namespace semigroups {
+  namespace {
+    using libsemigroups::letter_type;
+    using libsemigroups::Presentation;
+    using libsemigroups::word_type;
+    using relation_type = std::pair<word_type, word_type>;
+
+    ////////////////////////////////////////////////////////////////////////
+    // Words
+    ////////////////////////////////////////////////////////////////////////
+
+    bool is_prefix(word_type::const_iterator first,
+                   word_type::const_iterator last,
+                   word_type const&          u) {
+      return static_cast<size_t>(last - first) >= u.size()
+             && std::equal(u.cbegin(), u.cend(), first);
+    }
+
+    bool contains_subword(word_type const& w, word_type const& u) {
+      return std::search(w.cbegin(), w.cend(), u.cbegin(), u.cend())
+             != w.cend();
+    }
+
+    // Returns the number of occurrences of <u> in <w> that are found by
+    // reading <w> from left to right, and skipping to the end of every
+    // occurrence found, i.e. the occurrences replaced by replace_subwords.
+    size_t count_subwords(word_type const& w, word_type const& u) {
+      size_t result = 0;
+      auto   it     = std::search(w.cbegin(), w.cend(), u.cbegin(), u.cend());
+      while (it != w.cend()) {
+        ++result;
+        it = std::search(it + u.size(), w.cend(), u.cbegin(), u.cend());
+      }
+      return result;
+    }
+
+    // Replaces the occurrences of <u> in <w> counted by count_subwords with
+    // <v>, in the same way as SEMIGROUPS.StzReplaceSubwordRel. This is done
+    // in place if <v> is not longer than <u>.
+    void replace_subwords(word_type&       w,
+                          word_type const& u,
+                          word_type const& v) {
+      auto first = std::search(w.begin(), w.end(), u.cbegin(), u.cend());
+      if (first == w.end()) {
+        return;
+      }
+      if (v.size() <= u.size()) {
+        auto out = first;
+        auto in  = first;
+        while (in != w.end()) {
+          if (is_prefix(in, w.end(), u)) {
+            out = std::copy(v.cbegin(), v.cend(), out);
+            in += u.size();
+          } else {
+            *out++ = *in++;
+          }
+        }
+        w.erase(out, w.end());
+      } else {
+        word_type result(w.begin(), first);
+        auto      in = w.cbegin() + (first - w.begin());
+        while (in != w.cend()) {
+          if (is_prefix(in, w.cend(), u)) {
+            result.insert(result.end(), v.cbegin(), v.cend());
+            in += u.size();
+          } else {
+            result.push_back(*in++);
+          }
+        }
+        w = std::move(result);
+      }
+    }
+
+    // Returns true if no proper non-empty prefix of <w> is also a suffix of
+    // <w>, in which case no two occurrences of <w> in any word overlap.
+    bool is_unbordered(word_type const& w) {
+      std::vector<size_t> border(w.size(), 0);
+      for (size_t i = 1; i < w.size(); ++i) {
+        size_t k = border[i - 1];
+        while (k > 0 && w[i] != w[k]) {
+          k = border[k - 1];
+        }
+        border[i] = (w[i] == w[k] ? k + 1 : 0);
+      }
+      return w.empty() || border.back() == 0;
+    }
+
+    ////////////////////////////////////////////////////////////////////////
+    // SuffixAutomaton
+    ////////////////////////////////////////////////////////////////////////
+
+    // A suffix automaton of the sides of some relations. The sides are
+    // concatenated, each followed by a distinct letter that does not occur
+    // in any relation, and so every word occurring more than once in the
+    // concatenation is a subword of the sides. Every state corresponds to the
+    // set of subwords of the concatenation with the same set of end
+    // positions, these are the suffixes of the longest such subword whose
+    // length is greater than the length of the longest subword of the state
+    // reached by the suffix link.
+    class SuffixAutomaton {
+      struct State {
+        size_t                        length;
+        size_t                        link;
+        size_t                        first_end;
+        size_t                        count;
+        std::map<letter_type, size_t> next;
+      };
+
+      std::vector<State> _states;
+      word_type          _text;
+      size_t             _last;
+
+     public:
+      static constexpr size_t npos = static_cast<size_t>(-1);
+
+      explicit SuffixAutomaton(std::vector<relation_type> const& rels)
+          : _states(), _text(), _last(0) {
+        size_t len = 0;
+        for (auto const& rel : rels) {
+          len += rel.first.size() + rel.second.size() + 2;
+        }
+        _text.reserve(len);
+        _states.reserve(2 * len + 1);
+        _states.push_back(State({0, npos, 0, 0, {}}));
+
+        letter_type sep = std::numeric_limits<letter_type>::max();
+        for (auto const& rel : rels) {
+          for (auto const& x : rel.first) {
+            add(x);
+          }
+          add(sep--);
+          for (auto const& x : rel.second) {
+            add(x);
+          }
+          add(sep--);
+        }
+
+        // The number of occurrences of the subwords of a state is the
+        // number of states, not created as clones, from which it can be
+        // reached by following suffix links.
+        std::vector<std::vector<size_t>> by_length(_text.size() + 1);
+        for (size_t s = 1; s < _states.size(); ++s) {
+          by_length[_states[s].length].push_back(s);
+        }
+        for (size_t n = _text.size(); n > 0; --n) {
+          for (auto const& s : by_length[n]) {
+            _states[_states[s].link].count += _states[s].count;
+          }
+        }
+      }
+
+      word_type const& text() const noexcept {
+        return _text;
+      }
+
+      size_t number_of_states() const noexcept {
+        return _states.size();
+      }
+
+      size_t length(size_t s) const noexcept {
+        return _states[s].length;
+      }
+
+      size_t link(size_t s) const noexcept {
+        return _states[s].link;
+      }
+
+      // The position in text() of the last letter of the first occurrence of
+      // the subwords of <s>.
+      size_t first_end(size_t s) const noexcept {
+        return _states[s].first_end;
+      }
+
+      // The number of (possibly overlapping) occurrences in text() of the
+      // subwords of <s>.
+      size_t count(size_t s) const noexcept {
+        return _states[s].count;
+      }
+
+      // Returns the state of the subword <w>, or npos if <w> is not a
+      // subword of text().
+      size_t state(word_type const& w) const {
+        size_t s = 0;
+        for (auto const& x : w) {
+          auto it = _states[s].next.find(x);
+          if (it == _states[s].next.cend()) {
+            return npos;
+          }
+          s = it->second;
+        }
+        return s;
+      }
+
+     private:
+      void add(letter_type x) {
+        size_t const cur = _states.size();
+        _states.push_back(
+            State({_states[_last].length + 1, 0, _text.size(), 1, {}}));
+        _text.push_back(x);
+
+        size_t p = _last;
+        while (p != npos && _states[p].next.count(x) == 0) {
+          _states[p].next.emplace(x, cur);
+          p = _states[p].link;
+        }
+        if (p != npos) {
+          size_t const q = _states[p].next.find(x)->second;
+          if (_states[p].length + 1 == _states[q].length) {
+            _states[cur].link = q;
+          } else {
+            size_t const clone = _states.size();
+            State        st    = _states[q];
+            st.length          = _states[p].length + 1;
+            st.count           = 0;
+            _states.push_back(std::move(st));
+            while (p != npos) {
+              auto it = _states[p].next.find(x);
+              if (it == _states[p].next.end() || it->second != q) {
+                break;
+              }
+              it->second = clone;
+              p          = _states[p].link;
+            }
+            _states[q].link   = clone;
+            _states[cur].link = clone;
+          }
+        }
+        _last = cur;
+      }
+    };
+
+    constexpr size_t SuffixAutomaton::npos;
+
+    // Returns the number of occurrences of the subword <w> of the
+    // relations in <sa> counted by count_subwords, summed over all of the
+    // sides of the relations.
+    size_t count_subwords(SuffixAutomaton const& sa, word_type const& w) {
+      size_t const s = sa.state(w);
+      if (s == SuffixAutomaton::npos) {
+        return 0;
+      } else if (sa.count(s) <= 1 || is_unbordered(w)) {
+        return sa.count(s);
+      }
+      return count_subwords(sa.text(), w);
+    }
+
+    ////////////////////////////////////////////////////////////////////////
+    // Tietze
+    ////////////////////////////////////////////////////////////////////////
+
+    class Tietze {
+      enum class Kind {
+        redundant_generator,
+        duplicate_relation,
+        substitute_relation,
+        frequent_subword,
+        trivial_relation
+      };
+
+      // A transformation, and the length of the presentation after it is
+      // applied.
+      struct Candidate {
+        size_t      length;
+        Kind        kind;
+        size_t      relation;
+        letter_type generator;
+        word_type   word;
+      };
+
+      // A transformation that has been applied, as required to reproduce
+      // the messages printed by StzSimplifyPresentation.
+      struct Step {
+        Kind          kind;
+        letter_type   generator;
+        size_t        relation;
+        relation_type words;
+        size_t        number_of_generators;
+        size_t        number_of_relations;
+        size_t        length;
+      };
+
+      // The generators are numbered 0, 1, ..., in the order they were
+      // introduced, and are never renumbered. Every relation is a pair of
+      // words in these numbers.
+      std::vector<letter_type>   _gens;
+      std::vector<relation_type> _rels;
+      std::vector<word_type>     _forward;
+      std::vector<word_type>     _backward;
+      bool                       _trace;
+      std::vector<Step>          _steps;
+
+     public:
+      Tietze(Presentation<word_type> const& p, bool trace)
+          : _gens(),
+            _rels(),
+            _forward(),
+            _backward(),
+            _trace(trace),
+            _steps() {
+        size_t const n = p.alphabet().size();
+        for (letter_type a = 0; a < n; ++a) {
+          _gens.push_back(a);
+          _forward.push_back({a});
+          _backward.push_back({a});
+        }
+        for (size_t i = 0; i + 1 < p.rules.size(); i += 2) {
+          _rels.emplace_back(p.rules[i], p.rules[i + 1]);
+        }
+      }
+
+      size_t length() const noexcept {
+        size_t result = _gens.size();
+        for (auto const& rel : _rels) {
+          result += rel.first.size() + rel.second.size();
+        }
+        return result;
+      }
+
+      // Applies the transformation that reduces the length of the
+      // presentation the most, and returns true, or returns false if there
+      // is no such transformation.
+      bool simplify_once() {
+        if (_rels.empty()) {
+          return false;
+        }
+        size_t const          len = length();
+        SuffixAutomaton const sa(_rels);
+
+        Candidate best = {len, Kind::trivial_relation, 0, 0, {}};
+        auto consider  = [&best](Candidate&& c) {
+          if (c.length < best.length) {
+            best = std::move(c);
+          }
+        };
+        consider(redundant_generator(len));
+        consider(duplicate_relation(len));
+        consider(substitute_relation(len, sa));
+        consider(frequent_subword(len, sa));
+        consider(trivial_relation(len));
+
+        if (best.length == len) {
+          return false;
+        }
+        if (_trace) {
+          _steps.push_back({best.kind,
+                            best.generator,
+                            best.relation,
+                            (best.kind == Kind::frequent_subword
+                                 ? relation_type(best.word, {})
+                                 : _rels[best.relation]),
+                            0,
+                            0,
+                            0});
+        }
+        apply(best);
+        if (_trace) {
+          _steps.back().number_of_generators = _gens.size();
+          _steps.back().number_of_relations  = _rels.size();
+          _steps.back().length               = length();
+        }
+        return true;
+      }
+
+      Obj to_gap() const;
+
+     private:
+      ////////////////////////////////////////////////////////////////////////
+      // Checks - each returns the transformation of a particular kind that
+      // gives the shortest presentation, or one with length <len> if there is
+      // no such transformation that reduces the length.
+      ////////////////////////////////////////////////////////////////////////
+
+      // SEMIGROUPS.StzRedundantGeneratorCheck
+      Candidate redundant_generator(size_t len) const {
+        Candidate           result = {len, Kind::redundant_generator, 0, 0, {}};
+        std::vector<size_t> total(_backward.size(), 0);
+        for (auto const& rel : _rels) {
+          for (auto const& x : rel.first) {
+            total[x]++;
+          }
+          for (auto const& x : rel.second) {
+            total[x]++;
+          }
+        }
+        // The index of the first relation equal to each relation.
+        auto less = [](relation_type const* x, relation_type const* y) {
+          return *x < *y;
+        };
+        std::map<relation_type const*, size_t, decltype(less)> first(less);
+        for (size_t i = 0; i < _rels.size(); ++i) {
+          first.emplace(&_rels[i], i);
+        }
+
+        for (size_t i = 0; i < _rels.size(); ++i) {
+          word_type const& lhs = _rels[i].first;
+          word_type const& rhs = _rels[i].second;
+          if (lhs.size() == 1 && rhs.size() == 1) {
+            if (lhs != rhs && len - 3 < result.length) {
+              result.length    = len - 3;
+              result.generator = lhs[0];
+              result.relation  = first.find(&_rels[i])->second;
+            }
+            continue;
+          }
+          letter_type      gen;
+          word_type const* w;
+          if (lhs.size() == 1
+              && std::find(rhs.cbegin(), rhs.cend(), lhs[0]) == rhs.cend()) {
+            gen = lhs[0];
+            w   = &rhs;
+          } else if (rhs.size() == 1
+                     && std::find(lhs.cbegin(), lhs.cend(), rhs[0])
+                            == lhs.cend()) {
+            gen = rhs[0];
+            w   = &lhs;
+          } else {
+            continue;
+          }
+          size_t const j  = first.find(&_rels[i])->second;
+          auto const&  rj = _rels[j];
+          size_t const nr
+              = total[gen]
+                - std::count(rj.first.cbegin(), rj.first.cend(), gen)
+                - std::count(rj.second.cbegin(), rj.second.cend(), gen);
+          size_t const m = len + nr * (w->size() - 1) - 2 - w->size();
+          if (m < result.length) {
+            result.length    = m;
+            result.generator = gen;
+            result.relation  = j;
+          }
+        }
+        return result;
+      }
+
+      // SEMIGROUPS.StzDuplicateRelsCheck
+      Candidate duplicate_relation(size_t len) const {
+        Candidate result = {len, Kind::duplicate_relation, 0, 0, {}};
+        if (_rels.size() < 2) {
+          return result;
+        }
+        // Relations are duplicates if their sides are equal up to order.
+        using key_type = std::pair<word_type const*, word_type const*>;
+        auto key       = [](relation_type const& rel) {
+          return rel.second < rel.first
+                     ? key_type(&rel.second, &rel.first)
+                     : key_type(&rel.first, &rel.second);
+        };
+        auto less = [](key_type const& x, key_type const& y) {
+          return *x.first < *y.first
+                 || (*x.first == *y.first && *x.second < *y.second);
+        };
+        std::map<key_type, size_t, decltype(less)> number(less);
+        for (auto const& rel : _rels) {
+          number[key(rel)]++;
+        }
+        for (size_t i = 0; i < _rels.size(); ++i) {
+          size_t const m
+              = len - _rels[i].first.size() - _rels[i].second.size();
+          if (number[key(_rels[i])] > 1 && m < result.length) {
+            result.length   = m;
+            result.relation = i;
+          }
+        }
+        return result;
+      }
+
+      // SEMIGROUPS.StzRelsSubCheck
+      Candidate substitute_relation(size_t len,
+                                    SuffixAutomaton const& sa) const {
+        Candidate result = {len, Kind::substitute_relation, 0, 0, {}};
+        for (size_t i = 0; i < _rels.size(); ++i) {
+          word_type const* u = &_rels[i].first;
+          word_type const* v = &_rels[i].second;
+          if (u->size() > v->size()) {
+            std::swap(u, v);
+          }
+          if (u->size() == v->size()) {
+            continue;
+          }
+          // Every occurrence of <v>, apart from the side <v> itself, is
+          // replaced by <u>.
+          size_t const m
+              = len - (count_subwords(sa, *v) - 1) * (v->size() - u->size());
+          if (m < result.length) {
+            result.length   = m;
+            result.relation = i;
+          }
+        }
+        return result;
+      }
+
+      // SEMIGROUPS.StzFrequentSubwordCheck
+      //
+      // Introducing a new generator equal to a subword w of length n with c
+      // non-overlapping occurrences reduces the length of the presentation by
+      // (c - 1) * (n - 1) - 3. StzFrequentSubwordCheck finds the subword of
+      // length at least 2 for which this is greatest by considering the
+      // subwords of the sides in order of their first occurrence, and then
+      // their length; the first one found that reduces the length the most is
+      // chosen.
+      //
+      // The number of possibly overlapping occurrences of the subwords of a
+      // state of the suffix automaton is an upper bound for c, and it is
+      // equal to c if w is unbordered. The states are considered in
+      // decreasing order of this bound, so that c only has to be computed by
+      // searching the relations for a few subwords.
+      Candidate frequent_subword(size_t len, SuffixAutomaton const& sa) const {
+        Candidate result = {len, Kind::frequent_subword, 0, 0, {}};
+
+        auto bound = [&sa](size_t s, size_t n) -> int64_t {
+          return (static_cast<int64_t>(sa.count(s)) - 1)
+                     * (static_cast<int64_t>(n) - 1)
+                 - 3;
+        };
+        std::vector<size_t> states;
+        for (size_t s = 1; s < sa.number_of_states(); ++s) {
+          if (sa.count(s) > 1 && sa.length(s) > 1
+              && bound(s, sa.length(s)) > 0) {
+            states.push_back(s);
+          }
+        }
+        std::sort(states.begin(),
+                  states.end(),
+                  [&sa, &bound](size_t s, size_t t) {
+                    return bound(s, sa.length(s)) > bound(t, sa.length(t));
+                  });
+
+        word_type const& text       = sa.text();
+        int64_t          best       = 0;
+        size_t           best_first = 0;
+        size_t           best_n     = 0;
+        for (auto const& s : states) {
+          if (bound(s, sa.length(s)) < best) {
+            break;
+          }
+          size_t const min_n = std::max(size_t(2), sa.length(sa.link(s)) + 1);
+          for (size_t n = sa.length(s); n >= min_n; --n) {
+            int64_t const ub = bound(s, n);
+            if (ub <= 0 || ub < best) {
+              break;
+            }
+            size_t const first = sa.first_end(s) + 1 - n;
+            if (ub == best
+                && (first > best_first
+                    || (first == best_first && n > best_n))) {
+              continue;
+            }
+            word_type const w(text.cbegin() + first, text.cbegin() + first + n);
+            size_t const    c
+                = (is_unbordered(w) ? sa.count(s) : count_subwords(text, w));
+            int64_t const gain = (static_cast<int64_t>(c) - 1)
+                                     * (static_cast<int64_t>(n) - 1)
+                                 - 3;
+            if (gain > best
+                || (gain == best && gain > 0
+                    && (first < best_first
+                        || (first == best_first && n < best_n)))) {
+              best       = gain;
+              best_first = first;
+              best_n     = n;
+            }
+          }
+        }
+        if (best > 0) {
+          result.length = len - best;
+          result.word.assign(text.cbegin() + best_first,
+                             text.cbegin() + best_first + best_n);
+        }
+        return result;
+      }
+
+      // SEMIGROUPS.StzTrivialRelationCheck
+      Candidate trivial_relation(size_t len) const {
+        Candidate result = {len, Kind::trivial_relation, 0, 0, {}};
+        for (size_t i = 0; i < _rels.size(); ++i) {
+          size_t const m = len - 2 * _rels[i].first.size();
+          if (_rels[i].first == _rels[i].second && m < result.length) {
+            result.length   = m;
+            result.relation = i;
+          }
+        }
+        return result;
+      }
+
+      ////////////////////////////////////////////////////////////////////////
+      // Transformations - these modify the relations in the same way as the
+      // corresponding SEMIGROUPS.Stz*Apply function.
+      ////////////////////////////////////////////////////////////////////////
+
+      void apply(Candidate const& c) {
+        switch (c.kind) {
+          case Kind::redundant_generator:
+            remove_generator(c.generator, c.relation);
+            break;
+          case Kind::duplicate_relation:
+          case Kind::trivial_relation:
+            _rels.erase(_rels.begin() + c.relation);
+            break;
+          case Kind::substitute_relation:
+            substitute_relation(c.relation);
+            break;
+          case Kind::frequent_subword:
+            add_generator(c.word);
+            break;
+        }
+      }
+
+      // SEMIGROUPS.TietzeTransformation4
+      void remove_generator(letter_type gen, size_t i) {
+        relation_type rel = std::move(_rels[i]);
+        _rels.erase(_rels.begin() + i);
+        word_type const& expr
+            = (rel.first == word_type({gen}) ? rel.second : rel.first);
+        word_type const u = {gen};
+        for (auto& w : _forward) {
+          replace_subwords(w, u, expr);
+        }
+        for (auto& r : _rels) {
+          replace_subwords(r.first, u, expr);
+          replace_subwords(r.second, u, expr);
+        }
+        _gens.erase(std::find(_gens.begin(), _gens.end(), gen));
+      }
+
+      // SEMIGROUPS.StzRelsSubApply
+      void substitute_relation(size_t i) {
+        word_type u = _rels[i].first;
+        word_type v = _rels[i].second;
+        if (u.size() > v.size()) {
+          std::swap(u, v);
+        }
+        // The relations that are changed are moved to the end.
+        std::vector<relation_type> unchanged, changed;
+        for (size_t j = 0; j < _rels.size(); ++j) {
+          relation_type& rel = _rels[j];
+          if (j != i
+              && (contains_subword(rel.first, v)
+                  || contains_subword(rel.second, v))) {
+            replace_subwords(rel.first, v, u);
+            replace_subwords(rel.second, v, u);
+            changed.push_back(std::move(rel));
+          } else {
+            unchanged.push_back(std::move(rel));
+          }
+        }
+        _rels = std::move(unchanged);
+        for (auto& rel : changed) {
+          _rels.push_back(std::move(rel));
+        }
+      }
+
+      // SEMIGROUPS.StzFrequentSubwordApply
+      void add_generator(word_type const& w) {
+        letter_type const gen = _backward.size();
+        word_type         back;
+        for (auto const& x : w) {
+          back.insert(back.end(), _backward[x].cbegin(), _backward[x].cend());
+        }
+        _backward.push_back(std::move(back));
+        _gens.push_back(gen);
+
+        word_type const v = {gen};
+        for (auto& rel : _rels) {
+          replace_subwords(rel.first, w, v);
+          replace_subwords(rel.second, w, v);
+        }
+        _rels.insert(_rels.begin(), relation_type(w, v));
+      }
+    };
+
+    ////////////////////////////////////////////////////////////////////////
+    // Conversion to GAP
+    ////////////////////////////////////////////////////////////////////////
+
+    // Returns the GAP list whose entries are f(x) for the letters x of <w>.
+    template <typename F>
+    Obj word_to_gap(word_type const& w, F&& f) {
+      Obj result = NEW_PLIST(w.empty() ? T_PLIST_EMPTY : T_PLIST_CYC, w.size());
+      SET_LEN_PLIST(result, w.size());
+      for (size_t i = 0; i < w.size(); ++i) {
+        SET_ELM_PLIST(result, i + 1, INTOBJ_INT(f(w[i])));
+      }
+      return result;
+    }
+
+    template <typename F>
+    Obj relation_to_gap(relation_type const& rel, F&& f) {
+      Obj result = NEW_PLIST(T_PLIST_TAB, 2);
+      SET_LEN_PLIST(result, 2);
+      SET_ELM_PLIST(result, 1, word_to_gap(rel.first, f));
+      CHANGED_BAG(result);
+      SET_ELM_PLIST(result, 2, word_to_gap(rel.second, f));
+      CHANGED_BAG(result);
+      return result;
+    }
+
+    // Returns a GAP list of length <n> whose i-th entry is f(i).
+    template <typename F>
+    Obj list_to_gap(size_t n, F&& f) {
+      Obj result = NEW_PLIST(n == 0 ? T_PLIST_EMPTY : T_PLIST, n);
+      SET_LEN_PLIST(result, n);
+      for (size_t i = 0; i < n; ++i) {
+        Obj x = f(i);
+        SET_ELM_PLIST(result, i + 1, x);
+        CHANGED_BAG(result);
+      }
+      return result;
+    }
+
+    Obj Tietze::to_gap() const {
+      // The position of every remaining generator.
+      std::vector<size_t> pos(_backward.size(), 0);
+      for (size_t i = 0; i < _gens.size(); ++i) {
+        pos[_gens[i]] = i + 1;
+      }
+      auto position = [&pos](letter_type x) { return pos[x]; };
+      auto number   = [](letter_type x) { return x + 1; };
+
+      Obj result = NEW_PREC(6);
+      AssPRec(result, RNamName("generators"), word_to_gap(_gens, number));
+      AssPRec(result,
+              RNamName("relations"),
+              list_to_gap(_rels.size(), [this, &position](size_t i) {
+                return relation_to_gap(_rels[i], position);
+              }));
+      AssPRec(result,
+              RNamName("forward"),
+              list_to_gap(_forward.size(), [this, &position](size_t i) {
+                return word_to_gap(_forward[i], position);
+              }));
+      AssPRec(result,
+              RNamName("backward"),
+              list_to_gap(_gens.size(), [this, &number](size_t i) {
+                return word_to_gap(_backward[_gens[i]], number);
+              }));
+      AssPRec(result,
+              RNamName("new_generators"),
+              INTOBJ_INT(_backward.size() - _forward.size()));
+
+      static char const* const names[] = {"redundant_generator",
+                                          "duplicate_relation",
+                                          "substitute_relation",
+                                          "frequent_subword",
+                                          "trivial_relation"};
+      AssPRec(
+          result,
+          RNamName("steps"),
+          list_to_gap(_steps.size(), [this, &number](size_t i) {
+            Step const& step = _steps[i];
+            Obj         rec  = NEW_PREC(8);
+            AssPRec(rec,
+                    RNamName("kind"),
+                    MakeImmString(names[static_cast<size_t>(step.kind)]));
+            AssPRec(rec,
+                    RNamName("generator"),
+                    INTOBJ_INT(number(step.generator)));
+            AssPRec(rec, RNamName("relation"), INTOBJ_INT(step.relation + 1));
+            AssPRec(
+                rec, RNamName("lhs"), word_to_gap(step.words.first, number));
+            AssPRec(
+                rec, RNamName("rhs"), word_to_gap(step.words.second, number));
+            AssPRec(rec,
+                    RNamName("nr_generators"),
+                    INTOBJ_INT(step.number_of_generators));
+            AssPRec(rec,
+                    RNamName("nr_relations"),
+                    INTOBJ_INT(step.number_of_relations));
+            AssPRec(rec, RNamName("length"), INTOBJ_INT(step.length));
+            return rec;
+          }));
+      return result;
+    }
+  }  // namespace
+
+  Obj STZ_SIMPLIFY_PRESENTATION(Presentation<word_type> const& p, bool trace) {
+    p.validate();
+    for (size_t i = 0; i < p.alphabet().size(); ++i) {
+      if (p.alphabet()[i] != i) {
+        throw std::runtime_error(
+            "the alphabet of the 1st argument (a presentation) must be [0, "
+            + std::to_string(p.alphabet().size()) + ")");
+      }
+    }
+    for (auto const& w : p.rules) {
+      if (w.empty()) {
+        throw std::runtime_error(
+            "the 1st argument (a presentation) must not contain the empty "
+            "word");
+      }
+    }
+    Tietze stz(p, trace);
+    while (stz.simplify_once()) {
+    }
+    return stz.to_gap();
+  }
+}  // namespace semigroups
@@ -0,0 +1,59 @@
+//
+// Semigroups package for GAP
+// Copyright (C) 2025 James D. Mitchell
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+
+// This file contains the declaration of a function for simplifying a
+// presentation of a semigroup using Tietze transformations, which is used by
+// StzSimplifyPresentation.
+
+#ifndef SEMIGROUPS_SRC_TIETZE_HPP_
+#define SEMIGROUPS_SRC_TIETZE_HPP_
+
+// GAP headers
+#include "compiled.h"  // for Obj
+
+// libsemigroups headers
+#include "libsemigroups/present.hpp"  // for Presentation
+#include "libsemigroups/types.hpp"    // for word_type
+
+namespace semigroups {
+  // Repeatedly applies the Tietze transformation to <p> that reduces its
+  // length the most, in the same way as StzSimplifyOnce, until no such
+  // transformation reduces the length. The alphabet of <p> must be [0, n) for
+  // some n, and the rules of <p> must not contain the empty word; <p> itself
+  // is not modified.
+  //
+  // The generators of <p> are numbered 1 to n, and any generators introduced
+  // during the simplification are numbered n + 1, n + 2, ... in the order
+  // that they were introduced. The returned record has the components:
+  //
+  //   generators:       the numbers of the generators that remain, in order;
+  //   relations:        the relations of the simplified presentation, as
+  //                     pairs of words in the positions of the generators;
+  //   forward:          the i-th entry is the word in the simplified
+  //                     presentation equal to the i-th generator of <p>;
+  //   backward:         the i-th entry is the word in the generators of <p>
+  //                     equal to the i-th generator of the result;
+  //   new_generators:   the number of generators introduced;
+  //   steps:            if <trace> is true, a record for every transformation
+  //                     applied, see tietze.cpp, and otherwise empty.
+  Obj STZ_SIMPLIFY_PRESENTATION(
+      libsemigroups::Presentation<libsemigroups::word_type> const& p,
+      bool                                                         trace);
+}  // namespace semigroups
+
+#endif  // SEMIGROUPS_SRC_TIETZE_HPP_
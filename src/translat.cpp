@@ -0,0 +1,600 @@
+//
+// Semigroups package for GAP
+// Copyright (C) 2022 James D. Mitchell, Finn Smith
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+
+// This file contains a backtrack search for the left translations, right
+// translations, and bitranslations of a finite semigroup. It is a kernel
+// version of the search previously performed by the GAP functions
+// SEMIGROUPS.LeftTranslationsBacktrack, SEMIGROUPS.RightTranslationsBacktrack,
+// and SEMIGROUPS.BitranslationsBacktrack, and uses the data computed by
+// SEMIGROUPS.LeftTranslationsBacktrackData and
+// SEMIGROUPS.RightTranslationsBacktrackData.
+//
+// A left translation is determined by the images of the representatives
+// UnderlyingRepresentatives(LeftTranslations(S)), and so the search assigns
+// values to these representatives one at a time. The set of possible values
+// of every representative is stored as a bitset, and these sets are
+// restricted after each assignment using precomputed tables. Right
+// translations are dual, and bitranslations are found by alternately
+// assigning values to the left and right representatives.
+
+#include "translat.hpp"
+
+#include <algorithm>  // for min, max
+#include <cstddef>    // for size_t
+#include <cstdint>    // for uint32_t, uint64_t
+#include <iterator>   // for back_inserter
+#include <utility>    // for pair
+#include <vector>     // for vector
+
+// GAP headers
+#include "compiled.h"
+
+// Semigroups package for GAP headers
+#include "bitset.hpp"            // for Bitset
+#include "parallel.hpp"          // for number_of_threads, parallel_for
+#include "semigroups-debug.hpp"  // for SEMIGROUPS_ASSERT
+
+namespace semigroups {
+  namespace {
+    // The maximum number of bits used to store the precomputed restriction
+    // tables, if this would be exceeded the restrictions are computed as
+    // required instead.
+    constexpr size_t MAX_RESTRICTION_BITS = size_t(1) << 30;
+
+    constexpr uint32_t UNDEF = static_cast<uint32_t>(-1);
+
+    Obj get_component(Obj rec, char const* name) {
+      if (!IS_PREC(rec)) {
+        ErrorQuit("expected a plain record, found %s", (Int) TNAM_OBJ(rec), 0L);
+      }
+      UInt i;
+      if (!FindPRec(rec, RNamName(name), &i, 1)) {
+        ErrorQuit("expected a record with component %s", (Int) name, 0L);
+      }
+      return GET_ELM_PREC(rec, i);
+    }
+
+    // Returns the (1-based) i-th entry of the GAP list <list> minus 1.
+    inline uint32_t elm_minus_one(Obj list, size_t i) {
+      Obj val = ELM_LIST(list, i);
+      SEMIGROUPS_ASSERT(IS_INTOBJ(val) && INT_INTOBJ(val) > 0);
+      return INT_INTOBJ(val) - 1;
+    }
+
+    ////////////////////////////////////////////////////////////////////////
+    // TranslationsData
+    ////////////////////////////////////////////////////////////////////////
+
+    // This class contains the data for one side (left or right) of the
+    // search, i.e. the C++ version of the record returned by
+    // SEMIGROUPS.LeftTranslationsBacktrackData or
+    // SEMIGROUPS.RightTranslationsBacktrackData. In the latter case all
+    // products are in the dual semigroup.
+    class TranslationsData {
+     public:
+      // <table> is the name of the component of <data> containing the
+      // multiplication table with an identity adjoined, <intersects> the
+      // name of the component containing the maximal R- or L-class
+      // intersections, <canon> the name of the component containing the
+      // canonical inverses, and <domains> the name of the component
+      // containing the initial restrictions on the values of the
+      // representatives.
+      TranslationsData(Obj         data,
+                       char const* table,
+                       char const* intersects,
+                       char const* canon,
+                       char const* domains)
+          : _n(INT_INTOBJ(get_component(data, "n"))),
+            _m(0),
+            _constraints(),
+            _domains(),
+            _inverses(),
+            _inverses_index(_n + 1, UNDEF),
+            _reps(),
+            _restrictions(),
+            _table() {
+        Obj repspos = get_component(data, "repspos");
+        _m          = LEN_LIST(repspos);
+        _reps.reserve(_m);
+        for (size_t i = 1; i <= _m; ++i) {
+          _reps.push_back(elm_minus_one(repspos, i));
+        }
+
+        Obj mult = get_component(data, table);
+        SEMIGROUPS_ASSERT(static_cast<size_t>(LEN_LIST(mult)) == _n + 1);
+        _table.resize((_n + 1) * (_n + 1));
+        for (size_t x = 0; x <= _n; ++x) {
+          Obj row = ELM_LIST(mult, x + 1);
+          SEMIGROUPS_ASSERT(static_cast<size_t>(LEN_LIST(row)) == _n + 1);
+          for (size_t y = 0; y <= _n; ++y) {
+            _table[x * (_n + 1) + y] = elm_minus_one(row, y + 1);
+          }
+        }
+
+        Obj dom = get_component(data, domains);
+        _domains.assign(_m, Bitset(_n));
+        for (size_t i = 0; i < _m; ++i) {
+          Obj list = ELM_LIST(dom, i + 1);
+          for (size_t k = 1; k <= static_cast<size_t>(LEN_LIST(list)); ++k) {
+            _domains[i].set(elm_minus_one(list, k));
+          }
+        }
+
+        // For every a in intersects[i][j], record the pair
+        // (canon[a][i], canon[a][j]), the restriction of the value of the
+        // j-th representative given the value s of the i-th is then the
+        // intersection over all such pairs (ti, tj) of the set of u such that
+        // u * tj = s * ti.
+        Obj inter = get_component(data, intersects);
+        Obj inv   = get_component(data, canon);
+        _constraints.resize(_m * _m);
+        for (size_t i = 0; i < _m; ++i) {
+          for (size_t j = i + 1; j < _m; ++j) {
+            Obj list = ELM_LIST(ELM_LIST(inter, i + 1), j + 1);
+            for (size_t k = 1; k <= static_cast<size_t>(LEN_LIST(list));
+                 ++k) {
+              Obj      a  = ELM_LIST(inv, INT_INTOBJ(ELM_LIST(list, k)));
+              uint32_t ti = elm_minus_one(a, i + 1);
+              uint32_t tj = elm_minus_one(a, j + 1);
+              _constraints[i * _m + j].emplace_back(ti, tj);
+              if (_inverses_index[tj] == UNDEF) {
+                _inverses_index[tj] = _inverses.size();
+                _inverses.emplace_back(_n, Bitset(_n));
+                auto& col = _inverses.back();
+                for (size_t u = 0; u < _n; ++u) {
+                  col[product(u, tj)].set(u);
+                }
+              }
+            }
+          }
+        }
+      }
+
+      size_t number_of_reps() const noexcept {
+        return _m;
+      }
+
+      size_t size() const noexcept {
+        return _n;
+      }
+
+      size_t rep(size_t i) const noexcept {
+        return _reps[i];
+      }
+
+      Bitset const& domain(size_t i) const noexcept {
+        return _domains[i];
+      }
+
+      size_t product(size_t x, size_t y) const noexcept {
+        return _table[x * (_n + 1) + y];
+      }
+
+      // Precompute the restrictions on the value of the j-th representative
+      // given that the i-th representative has value s, for all i < j and s in
+      // domain(i), if this doesn't use too much memory.
+      void precompute(size_t nr_threads) {
+        size_t nr_bits = 0;
+        for (size_t i = 0; i < _m; ++i) {
+          nr_bits += (_m - i - 1) * _domains[i].count() * _n;
+        }
+        if (nr_bits > MAX_RESTRICTION_BITS) {
+          return;
+        }
+        _restrictions.assign(_m * _m, std::vector<Bitset>());
+        parallel_for(_m * _m, nr_threads, [this](size_t k) {
+          size_t const i = k / _m, j = k % _m;
+          if (j <= i) {
+            return;
+          }
+          auto& table = _restrictions[k];
+          table.resize(_n);
+          auto const& dom = _domains[i];
+          for (size_t s = dom.first(); s != Bitset::npos; s = dom.next(s + 1)) {
+            table[s].resize(_n);
+            compute_restriction(i, j, s, table[s]);
+          }
+        });
+      }
+
+      // Returns the restriction on the value of the j-th representative given
+      // that the i-th representative has value s, <tmp> is used as temporary
+      // storage if the restrictions were not precomputed.
+      Bitset const&
+      restriction(size_t i, size_t j, size_t s, Bitset& tmp) const {
+        SEMIGROUPS_ASSERT(i < j);
+        if (!_restrictions.empty()) {
+          SEMIGROUPS_ASSERT(_restrictions[i * _m + j][s].size() == _n);
+          return _restrictions[i * _m + j][s];
+        }
+        tmp.resize(_n);
+        compute_restriction(i, j, s, tmp);
+        return tmp;
+      }
+
+     private:
+      void compute_restriction(size_t i, size_t j, size_t s, Bitset& result)
+          const {
+        result.set();
+        for (auto const& p : _constraints[i * _m + j]) {
+          size_t const x = product(s, p.first);
+          SEMIGROUPS_ASSERT(x < _n);
+          result &= _inverses[_inverses_index[p.second]][x];
+        }
+      }
+
+      size_t                                          _n;
+      size_t                                          _m;
+      std::vector<std::vector<std::pair<uint32_t, uint32_t>>> _constraints;
+      std::vector<Bitset>                             _domains;
+      std::vector<std::vector<Bitset>>                _inverses;
+      std::vector<uint32_t>                           _inverses_index;
+      std::vector<size_t>                             _reps;
+      std::vector<std::vector<Bitset>>                _restrictions;
+      std::vector<uint32_t>                           _table;
+    };
+
+    ////////////////////////////////////////////////////////////////////////
+    // TranslationsBacktrack
+    ////////////////////////////////////////////////////////////////////////
+
+    // This class performs the backtrack search. If only one of <left> and
+    // <right> is not nullptr, then the search is for left or right
+    // translations, and otherwise it is for bitranslations. The variables of
+    // the search are the images of the left representatives (with indices
+    // [0, l_m)) followed by those of the right representatives (with indices
+    // [l_m, l_m + r_m)).
+    class TranslationsBacktrack {
+      struct Step {
+        bool   left;
+        size_t index;
+      };
+
+      struct Node {
+        size_t                depth;
+        std::vector<uint32_t> values;
+        std::vector<Bitset>   domains;
+      };
+
+     public:
+      using result_type = std::vector<std::vector<uint32_t>>;
+
+      TranslationsBacktrack(TranslationsData const* left,
+                            TranslationsData const* right)
+          : _l_m(left == nullptr ? 0 : left->number_of_reps()),
+            _left(left),
+            _left_link(),
+            _n(left == nullptr ? right->size() : left->size()),
+            _r_m(right == nullptr ? 0 : right->number_of_reps()),
+            _right(right),
+            _right_link(),
+            _steps() {
+        // Alternately assign values to the left and right representatives,
+        // L1, R1, L2, R2, ...
+        for (size_t i = 0; i < std::max(_l_m, _r_m); ++i) {
+          if (i < _l_m) {
+            _steps.push_back({true, i});
+          }
+          if (i < _r_m) {
+            _steps.push_back({false, i});
+          }
+        }
+        if (_left != nullptr && _right != nullptr) {
+          // _left_link[i][x] is the set of t such that t * l_i = x, and
+          // _right_link[i][x] is the set of t such that r_i * t = x where
+          // l_i and r_i are the i-th left and right representatives.
+          _left_link.assign(_l_m, std::vector<Bitset>(_n, Bitset(_n)));
+          for (size_t i = 0; i < _l_m; ++i) {
+            for (size_t t = 0; t < _n; ++t) {
+              _left_link[i][_left->product(t, _left->rep(i))].set(t);
+            }
+          }
+          _right_link.assign(_r_m, std::vector<Bitset>(_n, Bitset(_n)));
+          for (size_t i = 0; i < _r_m; ++i) {
+            for (size_t t = 0; t < _n; ++t) {
+              _right_link[i][_left->product(_right->rep(i), t)].set(t);
+            }
+          }
+        }
+      }
+
+      uint64_t count(size_t nr_threads) {
+        std::vector<uint64_t> counts;
+        run(nr_threads, [&counts](size_t nr_nodes) { counts.resize(nr_nodes); },
+            [&counts](size_t k, std::vector<uint32_t> const&) {
+              counts[k]++;
+            });
+        uint64_t result = 0;
+        for (auto const& c : counts) {
+          result += c;
+        }
+        return result;
+      }
+
+      result_type enumerate(size_t nr_threads) {
+        std::vector<result_type> results;
+        run(nr_threads,
+            [&results](size_t nr_nodes) { results.resize(nr_nodes); },
+            [&results](size_t k, std::vector<uint32_t> const& values) {
+              results[k].push_back(values);
+            });
+        result_type result;
+        for (auto& r : results) {
+          std::move(r.begin(), r.end(), std::back_inserter(result));
+        }
+        return result;
+      }
+
+      size_t number_of_left_reps() const noexcept {
+        return _l_m;
+      }
+
+      size_t number_of_right_reps() const noexcept {
+        return _r_m;
+      }
+
+     private:
+      size_t variable(Step const& step) const noexcept {
+        return step.left ? step.index : _l_m + step.index;
+      }
+
+      Bitset const& initial_domain(size_t v) const noexcept {
+        return v < _l_m ? _left->domain(v) : _right->domain(v - _l_m);
+      }
+
+      // Restrict the domains <from> of the unassigned variables after the
+      // variable of the step at <depth> is assigned the value <s>, and write
+      // the results in <to>. Returns false if some restricted domain is
+      // empty.
+      bool propagate(size_t                     depth,
+                    size_t                     s,
+                    std::vector<Bitset> const& from,
+                    std::vector<Bitset>&       to,
+                    Bitset&                    tmp) const {
+        size_t const i  = _steps[depth].index;
+        bool const   bi = _left != nullptr && _right != nullptr;
+        if (_steps[depth].left) {
+          for (size_t j = i + 1; j < _l_m; ++j) {
+            if (!to[j].intersection(from[j],
+                                    _left->restriction(i, j, s, tmp))) {
+              return false;
+            }
+          }
+          // linking condition x_j * lambda(x_i) = (x_j)rho * x_i
+          for (size_t j = i; bi && j < _r_m; ++j) {
+            size_t const x = _left->product(_right->rep(j), s);
+            if (!to[_l_m + j].intersection(from[_l_m + j],
+                                           _left_link[i][x])) {
+              return false;
+            }
+          }
+        } else {
+          for (size_t j = i + 1; j < _r_m; ++j) {
+            if (!to[_l_m + j].intersection(
+                    from[_l_m + j], _right->restriction(i, j, s, tmp))) {
+              return false;
+            }
+          }
+          for (size_t j = i + 1; bi && j < _l_m; ++j) {
+            size_t const x = _left->product(s, _left->rep(j));
+            if (!to[j].intersection(from[j], _right_link[i][x])) {
+              return false;
+            }
+          }
+        }
+        return true;
+      }
+
+      template <typename Func>
+      void dfs(size_t                            depth,
+               std::vector<std::vector<Bitset>>& stack,
+               std::vector<uint32_t>&            values,
+               Bitset&                           tmp,
+               Func&&                            found) const {
+        size_t const  v   = variable(_steps[depth]);
+        Bitset const& dom = stack[depth][v];
+        for (size_t s = dom.first(); s != Bitset::npos; s = dom.next(s + 1)) {
+          values[v] = s;
+          if (depth == _steps.size() - 1) {
+            found(values);
+          } else if (propagate(depth, s, stack[depth], stack[depth + 1], tmp)) {
+            dfs(depth + 1, stack, values, tmp, found);
+          }
+        }
+      }
+
+      // Split the search tree into subtrees, and search these subtrees in
+      // parallel, calling found(k, values) for every solution in the k-th
+      // subtree. The solutions in the k-th subtree all precede those in the
+      // (k + 1)-th in the order they would be found by a sequential search.
+      template <typename Init, typename Func>
+      void run(size_t nr_threads, Init&& init, Func&& found) {
+        size_t const nr_vars = _l_m + _r_m;
+        if (_steps.empty()) {
+          init(1);
+          found(0, std::vector<uint32_t>());
+          return;
+        }
+
+        std::vector<Node> frontier;
+        frontier.push_back(
+            {0, std::vector<uint32_t>(nr_vars, 0), std::vector<Bitset>()});
+        for (size_t v = 0; v < nr_vars; ++v) {
+          frontier.back().domains.push_back(initial_domain(v));
+        }
+
+        Bitset tmp;
+        // Expand the frontier until there are enough subtrees to keep all the
+        // threads busy.
+        while (nr_threads > 1 && frontier.size() < 16 * nr_threads
+               && frontier[0].depth < _steps.size() - 1) {
+          std::vector<Node> next;
+          for (auto& node : frontier) {
+            size_t const v = variable(_steps[node.depth]);
+            Bitset const dom = node.domains[v];
+            for (size_t s = dom.first(); s != Bitset::npos;
+                 s = dom.next(s + 1)) {
+              Node child{node.depth + 1,
+                         node.values,
+                         std::vector<Bitset>(nr_vars, Bitset(_n))};
+              child.values[v] = s;
+              if (propagate(node.depth, s, node.domains, child.domains, tmp)) {
+                next.push_back(std::move(child));
+              }
+            }
+          }
+          std::swap(frontier, next);
+          if (frontier.empty()) {
+            init(0);
+            return;
+          }
+        }
+
+        init(frontier.size());
+        parallel_for(frontier.size(), nr_threads, [&](size_t k) {
+          Node&                            node = frontier[k];
+          std::vector<std::vector<Bitset>> stack(
+              _steps.size(), std::vector<Bitset>(nr_vars, Bitset(_n)));
+          stack[node.depth] = std::move(node.domains);
+          Bitset local_tmp;
+          dfs(node.depth,
+              stack,
+              node.values,
+              local_tmp,
+              [&found, k](std::vector<uint32_t> const& values) {
+                found(k, values);
+              });
+        });
+      }
+
+      size_t                           _l_m;
+      TranslationsData const*          _left;
+      std::vector<std::vector<Bitset>> _left_link;
+      size_t                           _n;
+      size_t                           _r_m;
+      TranslationsData const*          _right;
+      std::vector<std::vector<Bitset>> _right_link;
+      std::vector<Step>                _steps;
+    };
+
+    Obj uint64_to_gap(uint64_t val) {
+      return ObjInt_UInt8(val);
+    }
+
+    Obj values_to_gap(std::vector<uint32_t> const& values,
+                      size_t                       first,
+                      size_t                       last) {
+      Obj result = NEW_PLIST(T_PLIST_CYC, last - first);
+      SET_LEN_PLIST(result, last - first);
+      for (size_t i = first; i < last; ++i) {
+        SET_ELM_PLIST(result, i - first + 1, INTOBJ_INT(values[i] + 1));
+      }
+      return result;
+    }
+
+    // Returns a list of lists of values of the representatives if there is
+    // only one side, and a list of pairs [lambda, rho] otherwise.
+    Obj results_to_gap(TranslationsBacktrack const&              bt,
+                       TranslationsBacktrack::result_type const& results) {
+      size_t const l_m = bt.number_of_left_reps();
+      size_t const r_m = bt.number_of_right_reps();
+      Obj          out = NEW_PLIST(T_PLIST, results.size());
+      SET_LEN_PLIST(out, results.size());
+      for (size_t k = 0; k < results.size(); ++k) {
+        Obj next;
+        if (l_m == 0) {
+          next = values_to_gap(results[k], 0, r_m);
+        } else if (r_m == 0) {
+          next = values_to_gap(results[k], 0, l_m);
+        } else {
+          next = NEW_PLIST(T_PLIST, 2);
+          SET_LEN_PLIST(next, 2);
+          SET_ELM_PLIST(next, 1, values_to_gap(results[k], 0, l_m));
+          CHANGED_BAG(next);
+          SET_ELM_PLIST(next, 2, values_to_gap(results[k], l_m, l_m + r_m));
+          CHANGED_BAG(next);
+        }
+        SET_ELM_PLIST(out, k + 1, next);
+        CHANGED_BAG(out);
+      }
+      return out;
+    }
+
+    Obj run_backtrack(TranslationsData* left,
+                      TranslationsData* right,
+                      Obj               nr_only,
+                      Obj               nr_threads) {
+      size_t const nr_thrds = number_of_threads(nr_threads);
+      if (left != nullptr) {
+        left->precompute(nr_thrds);
+      }
+      if (right != nullptr) {
+        right->precompute(nr_thrds);
+      }
+      TranslationsBacktrack bt(left, right);
+      if (nr_only == True) {
+        return uint64_to_gap(bt.count(nr_thrds));
+      }
+      return results_to_gap(bt, bt.enumerate(nr_thrds));
+    }
+  }  // namespace
+
+  // Returns the list of values of UnderlyingRepresentatives(LeftTranslations(
+  // S)) of all left translations of S, or the number of such translations if
+  // <nr_only> is true, where <data> is the record returned by
+  // SEMIGROUPS.LeftTranslationsBacktrackData(S).
+  Obj LEFT_TRANSLATIONS_BACKTRACK(Obj data, Obj nr_only, Obj nr_threads) {
+    TranslationsData left(
+        data, "multtable", "max_R_intersects", "left_canon_inverse_by_gen", "U");
+    return run_backtrack(&left, nullptr, nr_only, nr_threads);
+  }
+
+  // The dual of LEFT_TRANSLATIONS_BACKTRACK, where <data> is the record
+  // returned by SEMIGROUPS.RightTranslationsBacktrackData(S).
+  Obj RIGHT_TRANSLATIONS_BACKTRACK(Obj data, Obj nr_only, Obj nr_threads) {
+    TranslationsData right(data,
+                           "transpose_multtable",
+                           "max_L_intersects",
+                           "right_canon_inverse_by_gen",
+                           "T");
+    return run_backtrack(nullptr, &right, nr_only, nr_threads);
+  }
+
+  // Returns the list of pairs [lambda, rho] of values of the left and right
+  // representatives of all bitranslations of S, or the number of such
+  // bitranslations if <nr_only> is true.
+  Obj BITRANSLATIONS_BACKTRACK(Obj left_data,
+                               Obj right_data,
+                               Obj nr_only,
+                               Obj nr_threads) {
+    TranslationsData left(left_data,
+                          "multtable",
+                          "max_R_intersects",
+                          "left_canon_inverse_by_gen",
+                          "U");
+    TranslationsData right(right_data,
+                           "transpose_multtable",
+                           "max_L_intersects",
+                           "right_canon_inverse_by_gen",
+                           "T");
+    if (left.size() != right.size()) {
+      ErrorQuit("the arguments must be data for the same semigroup", 0L, 0L);
+    }
+    return run_backtrack(&left, &right, nr_only, nr_threads);
+  }
+}  // namespace semigroups
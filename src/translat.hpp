@@ -0,0 +1,37 @@
+//
+// Semigroups package for GAP
+// Copyright (C) 2022 James D. Mitchell, Finn Smith
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+
+// This file contains declarations of functions for computing the left
+// translations, right translations, and bitranslations of a finite semigroup
+// by backtrack search.
+
+#ifndef SEMIGROUPS_SRC_TRANSLAT_HPP_
+#define SEMIGROUPS_SRC_TRANSLAT_HPP_
+
+#include "compiled.h"  // for Obj
+
+namespace semigroups {
+  Obj LEFT_TRANSLATIONS_BACKTRACK(Obj data, Obj nr_only, Obj nr_threads);
+  Obj RIGHT_TRANSLATIONS_BACKTRACK(Obj data, Obj nr_only, Obj nr_threads);
+  Obj BITRANSLATIONS_BACKTRACK(Obj left_data,
+                               Obj right_data,
+                               Obj nr_only,
+                               Obj nr_threads);
+}  // namespace semigroups
+
+#endif  // SEMIGROUPS_SRC_TRANSLAT_HPP_
@@ -8,7 +8,7 @@
 #############################################################################
 ##
 
-#@local S, cong, cong_by_ker_trace_threshold
+#@local S, cong, cong_by_ker_trace_threshold, congs
 gap> START_TEST("Semigroups package: extreme/conginv.tst");
 gap> LoadPackage("semigroups", false);;
 
@@ -38,6 +38,17 @@ gap> SemigroupIdealOfReesCongruence(cong);
 <inverse partial perm semigroup ideal of size 57500, rank 8 with
   57500 generators>
 
+# CayleyDigraphOfCongruences: the kernel and trace method is used for I_6 with
+# the default value of cong_lattice_by_ker_trace_threshold
+gap> S := SymmetricInverseMonoid(6);;
+gap> Size(S) >= SEMIGROUPS.OptionsRec(S).cong_lattice_by_ker_trace_threshold;
+true
+gap> congs := CongruencesOfSemigroup(S);;
+gap> ForAll(congs, IsInverseSemigroupCongruenceByKernelTrace);
+true
+gap> HasLibsemigroupsCongruenceLattice(CayleyDigraphOfCongruences(S));
+false
+
 #
 gap> SEMIGROUPS.StopTest();
 gap> STOP_TEST("Semigroups package: extreme/conginv.tst");
@@ -9,7 +9,7 @@
 ##
 
 #@local A, BruteForceInverseCheck, BruteForceIsoCheck, F, G, S, T, U, V, inv
-#@local map, x, y, M, N, R, L
+#@local map, x, y, M, N, R, L, p
 gap> START_TEST("Semigroups package: standard/attributes/isomorph.tst");
 gap> LoadPackage("semigroups", false);;
 
@@ -38,7 +38,7 @@ gap> BruteForceInverseCheck := function(map)
 >     and ForAll(Range(map), x -> x = (x ^ inv) ^ map);
 > end;;
 
-# isomorph: SmallestMultiplicationTable, 1/2
+# isomorph: SmallestMultiplicationTable, 1/3
 gap> S := DualSymmetricInverseMonoid(2);
 <inverse block bijection monoid of degree 2 with 2 generators>
 gap> Size(S);
@@ -46,7 +46,7 @@ gap> Size(S);
 gap> SmallestMultiplicationTable(S);
 [ [ 1, 2, 3 ], [ 2, 1, 3 ], [ 3, 3, 3 ] ]
 
-# isomorph: SmallestMultiplicationTable, 2/2
+# isomorph: SmallestMultiplicationTable, 2/3
 gap> S := Semigroup(
 > [PBR([[-4, 1, 2, 3], [-4, 1, 2, 4], [-2, -1, 1], [-4, -1, 1, 2, 4]],
 >      [[-4, -3, 1, 4], [-3, -1, 3], [-4, -1, 1, 2, 4], [-4, -3, -2, 3, 4]]),
@@ -89,6 +89,22 @@ gap> CanonicalMultiplicationTable(S);
   [ 8, 11, 11, 10, 9, 11, 10, 8, 9, 10, 11 ], 
   [ 11, 11, 11, 10, 9, 11, 10, 8, 9, 10, 11 ] ]
 
+# isomorph: SmallestMultiplicationTable, 3/3
+gap> S := FullTransformationMonoid(3);;
+gap> M := MultiplicationTable(S);;
+gap> N := OnMultiplicationTable(M, (1, 5, 2)(3, 27, 4));;
+gap> T := SmallestMultiplicationTable(S);;
+gap> T = SmallestMultiplicationTable(SemigroupByMultiplicationTable(N));
+true
+gap> T = SmallestMultiplicationTable(SemigroupByMultiplicationTable(T));
+true
+gap> SmallestMultiplicationTable(CyclicGroup(IsPermGroup, 60))
+> = SmallestMultiplicationTable(CyclicGroup(IsPcGroup, 60));
+true
+gap> libsemigroups.SMALLEST_MULTIPLICATION_TABLE([[1, 2], [2, 3]]);
+Error, the 1st argument must be a non-empty square table of integers in the ra\
+nge [1, n], where n is the number of rows
+
 # isomorph: IsIsomorphicSemigroup, 1/2
 gap> S := DualSymmetricInverseMonoid(2);;
 gap> T := Semigroup([Transformation([2, 1, 2, 2]),
@@ -430,6 +446,36 @@ gap> AutomorphismGroup(S);
 Error, no method found! For debugging hints type ?Recovery from NoMethodFound
 Error, no 2nd choice method found for `AutomorphismGroup' on 1 arguments
 
+# OnMultiplicationTable, and the invariant used by IsomorphismSemigroups
+gap> S := FullTransformationMonoid(3);;
+gap> M := MultiplicationTable(S);;
+gap> p := (1, 5, 2)(3, 27, 4)(30, 31);;
+gap> N := OnMultiplicationTable(M, p);;
+gap> ForAll([1 .. 27], i -> ForAll([1 .. 27],
+> j -> N[i ^ p][j ^ p] = M[i][j] ^ p));
+true
+gap> OnMultiplicationTable(M, ()) = M;
+true
+gap> OnMultiplicationTable(M, (1, 28));
+Error, the 2nd argument (a permutation) must map [1 .. 27] to itself
+gap> OnMultiplicationTable([[1, 2], [2, 3]], ());
+Error, the 1st argument must be a non-empty square table of integers in the ra\
+nge [1, n], where n is the number of rows
+gap> libsemigroups.MULTIPLICATION_TABLE_INVARIANT(M)
+> = libsemigroups.MULTIPLICATION_TABLE_INVARIANT(N);
+true
+gap> S := SemigroupByMultiplicationTable(
+> [[1, 1, 1, 1], [1, 1, 1, 1], [1, 1, 1, 1], [1, 1, 1, 1]]);;
+gap> T := SemigroupByMultiplicationTable(
+> [[1, 1, 1, 1], [1, 1, 1, 1], [1, 1, 1, 1], [1, 1, 1, 2]]);;
+gap> NrRClasses(S) = NrRClasses(T) and NrLClasses(S) = NrLClasses(T);
+true
+gap> libsemigroups.MULTIPLICATION_TABLE_INVARIANT(MultiplicationTable(S))
+> = libsemigroups.MULTIPLICATION_TABLE_INVARIANT(MultiplicationTable(T));
+false
+gap> IsomorphismSemigroups(S, T);
+fail
+
 #
 gap> SEMIGROUPS.StopTest();
 gap> STOP_TEST("Semigroups package: standard/attributes/isomorph.tst");
@@ -614,6 +614,31 @@ true
 gap> NrBitranslations(S) = NrBitranslations(T);
 true
 
+# Kernel backtrack with one and with several threads
+gap> S := Semigroup([Transformation([1, 4, 3, 3, 5, 2]),
+> Transformation([3, 4, 1, 1, 4, 2])]);;
+gap> l := SEMIGROUPS.LeftTranslationsBacktrackData(S);;
+gap> r := SEMIGROUPS.RightTranslationsBacktrackData(S);;
+gap> libsemigroups.LEFT_TRANSLATIONS_BACKTRACK(l, true, 1);
+208
+gap> libsemigroups.LEFT_TRANSLATIONS_BACKTRACK(l, true, 4);
+208
+gap> libsemigroups.LEFT_TRANSLATIONS_BACKTRACK(l, false, 1)
+> = libsemigroups.LEFT_TRANSLATIONS_BACKTRACK(l, false, 4);
+true
+gap> libsemigroups.RIGHT_TRANSLATIONS_BACKTRACK(r, true, 4);
+128
+gap> libsemigroups.RIGHT_TRANSLATIONS_BACKTRACK(r, false, 1)
+> = libsemigroups.RIGHT_TRANSLATIONS_BACKTRACK(r, false, 4);
+true
+gap> libsemigroups.BITRANSLATIONS_BACKTRACK(l, r, true, 4);
+78
+gap> libsemigroups.BITRANSLATIONS_BACKTRACK(l, r, false, 1)
+> = libsemigroups.BITRANSLATIONS_BACKTRACK(l, r, false, 4);
+true
+gap> libsemigroups.LEFT_TRANSLATIONS_BACKTRACK(l, true, 0);
+Error, expected a positive integer, found integer
+
 # Error Testing - Left Translations
 gap> S := Semigroup([Transformation([1, 4, 3, 3, 6, 5]),
 > Transformation([3, 4, 1, 1, 4, 2])]);;
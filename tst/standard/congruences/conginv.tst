@@ -9,8 +9,8 @@
 ##
 
 #@local S, T, ccong, classx, classy, classz, cong, cong1, cong2
-#@local cong_by_ker_trace_threshold, g, min, pair, pair1, pair2, pairs, q
-#@local ttrace, utrace, x, y, z
+#@local cong_by_ker_trace_threshold, cong_lattice_by_ker_trace_threshold
+#@local congs, g, min, pair, pair1, pair2, pairs, q, ttrace, utrace, x, y, z
 gap> START_TEST("Semigroups package: standard/congruences/conginv.tst");
 gap> LoadPackage("semigroups", false);;
 
@@ -19,6 +19,7 @@ gap> SEMIGROUPS.StartTest();
 
 # Always use kernel-trace methods if possible in these tests
 gap> SEMIGROUPS.DefaultOptionsRec.cong_by_ker_trace_threshold := 0;;
+gap> SEMIGROUPS.DefaultOptionsRec.cong_lattice_by_ker_trace_threshold := 0;;
 
 # InverseCongTest1: Create an inverse semigroup congruence
 gap> S := InverseSemigroup([PartialPerm([1, 2, 3], [2, 5, 3]),
@@ -287,6 +288,30 @@ gap> cong := SemigroupCongruence(S, pairs);
 gap> EquivalenceRelationCanonicalLookup(cong);
 [ 1, 2, 3, 4, 4, 4, 5, 4, 4, 4, 4, 4, 4, 4 ]
 
+# CayleyDigraphOfCongruences, computed by kernels and traces in the kernel
+# module, compared with the generic method
+gap> S := InverseMonoid([PartialPerm([2, 3, 1]), PartialPerm([2, 1, 3]),
+>                        PartialPerm([1, 2])]);;
+gap> T := InverseMonoid(GeneratorsOfInverseMonoid(S),
+>                       rec(cong_by_ker_trace_threshold := 10 ^ 5,
+>                           cong_lattice_by_ker_trace_threshold := 10 ^ 5));;
+gap> congs := CongruencesOfSemigroup(S);;
+gap> Length(congs);
+7
+gap> ForAll(congs, IsInverseSemigroupCongruenceByKernelTrace);
+true
+gap> Set(congs, EquivalenceRelationCanonicalLookup)
+> = Set(CongruencesOfSemigroup(T), EquivalenceRelationCanonicalLookup);
+true
+gap> IsIsomorphicDigraph(LatticeOfCongruences(S), LatticeOfCongruences(T));
+true
+gap> NrEquivalenceClasses(congs[1]) = Size(S);
+true
+gap> ForAll(GeneratingCongruencesOfJoinSemilattice(
+>             CayleyDigraphOfCongruences(S)),
+>           C -> C in congs);
+true
+
 # 
 gap> SEMIGROUPS.StopTest();
 gap> STOP_TEST("Semigroups package: standard/congruences/conginv.tst");
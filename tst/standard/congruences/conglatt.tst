@@ -9,8 +9,8 @@
 #############################################################################
 ##
 
-#@local D, S, coll, congs, info, l, latt, min, minl, minr, numbers, pair1
-#@local pair2, pair3, poset, restriction, x
+#@local D, S, coll, congs, info, l, latt, lookups, min, minl, minr, numbers
+#@local pair1, pair2, pair3, pairs, poset, restriction, x
 gap> START_TEST("Semigroups package: standard/congruences/conglatt.tst");
 gap> LoadPackage("semigroups", false);;
 
@@ -36,6 +36,30 @@ gap> IsIsomorphicDigraph(l,
 true
 gap> IsLatticeDigraph(l);
 true
+
+# Joins and meets computed by LibsemigroupsCongruenceLattice
+gap> latt := LibsemigroupsCongruenceLattice(l);;
+gap> libsemigroups.CongruenceLattice.size(latt);
+13
+gap> congs := CongruencesOfPoset(l);;
+gap> ForAll([1 .. 13], i -> ForAll([1 .. 13],
+> j -> congs[libsemigroups.CongruenceLattice.join(latt, i - 1, j - 1) + 1]
+>      = JoinSemigroupCongruences(congs[i], congs[j])));
+true
+gap> ForAll([1 .. 13], i -> ForAll([1 .. 13],
+> j -> congs[libsemigroups.CongruenceLattice.meet(latt, i - 1, j - 1) + 1]
+>      = MeetSemigroupCongruences(congs[i], congs[j])));
+true
+gap> x := libsemigroups.CongruenceLattice.meet_table(latt, 2);;
+gap> ForAll([1 .. 13], i -> ForAll([1 .. 13],
+> j -> x[i][j] = libsemigroups.CongruenceLattice.meet(latt, i - 1, j - 1) + 1));
+true
+gap> x := libsemigroups.CongruenceLattice.join_table(latt, 2);;
+gap> ForAll([1 .. 13], i -> ForAll([1 .. 13],
+> j -> x[i][j] = libsemigroups.CongruenceLattice.join(latt, i - 1, j - 1) + 1));
+true
+gap> libsemigroups.CongruenceLattice.meet(latt, 13, 0);
+Error, the argument must be less than 13, found 13
 gap> S := OrderEndomorphisms(2);;
 gap> CongruencesOfSemigroup(S);
 [ <2-sided semigroup congruence over <regular transformation monoid 
@@ -289,6 +313,71 @@ gap> PrincipalLeftCongruencesOfSemigroup(S)[2];
 <left semigroup congruence over <transformation semigroup of size 4, degree 2 
  with 2 generators> with 1 generating pairs>
 
+# PrincipalCongruencesOfSemigroup, compare kernel lookups with those computed
+# from scratch
+gap> S := Semigroup([Transformation([2, 3, 1, 4]), Transformation([1, 1, 2, 3]),
+>                    Transformation([4, 4, 4, 4])]);;
+gap> congs := PrincipalCongruencesOfSemigroup(S);;
+gap> ForAll(congs, C -> HasEquivalenceRelationLookup(C));
+true
+gap> ForAll(congs,
+> C -> EquivalenceRelationCanonicalLookup(C) =
+>      EquivalenceRelationCanonicalLookup(
+>        SemigroupCongruence(S, GeneratingPairsOfSemigroupCongruence(C))));
+true
+gap> Length(Set(congs, EquivalenceRelationCanonicalLookup)) = Length(congs);
+true
+gap> IsSortedList(List(congs, NrEquivalenceClasses));
+true
+gap> congs := PrincipalRightCongruencesOfSemigroup(S);;
+gap> ForAll(congs,
+> C -> EquivalenceRelationCanonicalLookup(C) =
+>      EquivalenceRelationCanonicalLookup(
+>        RightSemigroupCongruence(S,
+>          GeneratingPairsOfRightSemigroupCongruence(C))));
+true
+gap> congs := PrincipalLeftCongruencesOfSemigroup(S);;
+gap> ForAll(congs,
+> C -> EquivalenceRelationCanonicalLookup(C) =
+>      EquivalenceRelationCanonicalLookup(
+>        LeftSemigroupCongruence(S,
+>          GeneratingPairsOfLeftSemigroupCongruence(C))));
+true
+
+# PrincipalCongruencesOfSemigroup, pairs generated in the kernel, with and
+# without pruning by the automorphisms given by the units
+gap> S := Monoid([Transformation([2, 3, 1]), Transformation([1, 1, 2])],
+>                rec(acting := false));;
+gap> pairs := Combinations(AsListCanonical(S), 2);;
+gap> lookups := Set(PrincipalCongruencesOfSemigroup(S, pairs),
+>                   EquivalenceRelationCanonicalLookup);;
+gap> congs := PrincipalCongruencesOfSemigroup(S);;
+gap> Set(congs, EquivalenceRelationCanonicalLookup) = lookups;
+true
+gap> Length(congs) = Length(lookups);
+true
+gap> ForAll(congs,
+> C -> EquivalenceRelationCanonicalLookup(C) =
+>      EquivalenceRelationCanonicalLookup(
+>        SemigroupCongruence(S, GeneratingPairsOfSemigroupCongruence(C))));
+true
+gap> S := Monoid([Transformation([2, 3, 1]), Transformation([1, 1, 2])],
+>                rec(acting := false));;
+gap> congs := PrincipalRightCongruencesOfSemigroup(S : symmetry := true);;
+gap> Set(congs, EquivalenceRelationCanonicalLookup)
+> = Set(PrincipalRightCongruencesOfSemigroup(S, pairs),
+>       EquivalenceRelationCanonicalLookup);
+true
+gap> ForAll(congs,
+> C -> EquivalenceRelationCanonicalLookup(C) =
+>      EquivalenceRelationCanonicalLookup(
+>        RightSemigroupCongruence(S,
+>          GeneratingPairsOfRightSemigroupCongruence(C))));
+true
+gap> ForAll(SEMIGROUPS.AutomorphismsByUnits(S),
+>           x -> IsDuplicateFreeList(x) and Length(x) = Size(S));
+true
+
 # MinimalCongruencesOfSemigroup
 gap> S := Semigroup([Transformation([1, 3, 2]), Transformation([3, 1, 3])]);;
 gap> min := MinimalCongruencesOfSemigroup(S);;
@@ -383,6 +472,25 @@ gap> poset := PosetOfCongruences(coll);
  degree 2 with 2 generators>>
 gap> InNeighbours(poset);
 [ [ 1, 3 ], [ 2, 3 ], [ 3 ] ]
+gap> S := Semigroup([Transformation([2, 3, 1, 4]), Transformation([1, 1, 2, 3]),
+>                    Transformation([4, 4, 4, 4])]);;
+gap> coll := CongruencesOfSemigroup(S);;
+gap> poset := PosetOfCongruences(coll);;
+gap> ForAll([1 .. Length(coll)], i -> ForAll([1 .. Length(coll)],
+> j -> (j in OutNeighboursOfVertex(poset, i)) =
+>      IsSubrelation(coll[j], coll[i])));
+true
+gap> HasDigraphReflexiveTransitiveReduction(poset);
+true
+gap> DigraphReflexiveTransitiveReduction(poset)
+> = DigraphReflexiveTransitiveReduction(DigraphMutableCopy(poset));
+true
+gap> poset := PosetOfCongruences(Concatenation(coll, coll{[1]}));;
+gap> HasDigraphReflexiveTransitiveReduction(poset);
+false
+gap> IsSubset(OutNeighboursOfVertex(poset, Length(coll) + 1),
+>             [1, Length(coll) + 1]);
+true
 
 # Trivial poset
 gap> poset := PosetOfCongruences([]);
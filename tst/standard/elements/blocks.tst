@@ -161,6 +161,18 @@ intObj method"
 gap> BLOCKS_NC([]);
 <empty blocks>
 
+# Test that equal blocks are identical
+gap> x := Bipartition([[1, 2, -1], [3, -2, -3]]);;
+gap> y := Bipartition([[1, 2, -1, -2], [3, -3]]);;
+gap> IsIdenticalObj(LeftBlocks(x), LeftBlocks(y));
+true
+gap> IsIdenticalObj(LeftBlocks(x), BLOCKS_NC([[1, 2], [3]]));
+true
+gap> IsIdenticalObj(RightBlocks(x), RightBlocks(y));
+false
+gap> IsIdenticalObj(RightBlocks(x * y), OnRightBlocks(RightBlocks(x), y));
+true
+
 # 
 gap> SEMIGROUPS.StopTest();
 gap> STOP_TEST("Semigroups package: standard/elements/blocks.tst");
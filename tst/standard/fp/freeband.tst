@@ -251,6 +251,32 @@ gap> ContentOfFreeBandElement(S.2 * S.1);
 gap> ContentOfFreeBandElementCollection([S.2 * S.1, x]);
 [ 1, 2, 3 ]
 
+# Test canonical forms of free band elements
+gap> S := FreeBand(3);;
+gap> x := S.1 * S.2 * S.1 * S.2;
+x1x2
+gap> y := S.1 * S.2;;
+gap> IsIdenticalObj(x, y);
+false
+gap> IsBound(x!.id);
+false
+gap> x = y;
+true
+gap> IsBound(x!.id) and IsBound(y!.id) and x!.id = y!.id;
+true
+gap> x < y or y < x;
+false
+gap> S.1 * S.3 * S.2 = S.1 * S.2 * S.3;
+false
+gap> Size(AsSSortedList(S));
+159
+gap> libsemigroups.FreeBandCanonicalForms.size(FamilyObj(x)!.canonical_forms)
+> >= 159;
+true
+gap> libsemigroups.FreeBandCanonicalForms.id(FamilyObj(x)!.canonical_forms,
+>                                            fail);
+Error, expected a free band element, found boolean or fail
+
 # Test ViewObj for large number of generators
 gap> FreeBand(100);
 <free band with 100 generators>
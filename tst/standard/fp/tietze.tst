@@ -607,6 +607,60 @@ gap> RelationsOfStzPresentation(stz);
 [  ]
 gap> SetInfoLevel(InfoFpSemigroup, prevFpSemigroupInfoLevel);;
 
+# Test StzSimplifyPresentation, 3
+gap> prevFpSemigroupInfoLevel := InfoLevel(InfoFpSemigroup);;
+gap> SetInfoLevel(InfoFpSemigroup, 1);;
+gap> f := FreeSemigroup("a", "b", "c");;
+gap> s := f / [[f.1, f.2 ^ 5 * f.3], [f.2 ^ 6, f.2 ^ 3]];;
+gap> stz := StzPresentation(s);;
+gap> StzSimplifyPresentation(stz);
+gap> GeneratorsOfStzPresentation(stz);
+[ "b", "c", "d" ]
+gap> RelationsOfStzPresentation(stz);
+[ [ [ 1, 1, 1 ], [ 3 ] ], [ [ 3, 3 ], [ 3 ] ] ]
+gap> TietzeForwardMap(stz);
+[ [ 1, 1, 1, 1, 1, 2 ], [ 1 ], [ 2 ] ]
+gap> TietzeBackwardMap(stz);
+[ [ 2 ], [ 3 ], [ 2, 2, 2 ] ]
+gap> SetInfoLevel(InfoFpSemigroup, prevFpSemigroupInfoLevel);;
+
+# Test StzSimplifyPresentation agrees with StzSimplifyOnce
+gap> prevFpSemigroupInfoLevel := InfoLevel(InfoFpSemigroup);;
+gap> SetInfoLevel(InfoFpSemigroup, 1);;
+gap> f := FreeSemigroup("a", "b", "c", "d");;
+gap> r := ParseRelations([f.1, f.2, f.3, f.4],
+>         "a^5=a,a^25=cb,(cb)^3=c,a=a^5,cb=cb,(cb)^12=b^12,d=a^10");;
+gap> s := f / r;;
+gap> stz1 := StzPresentation(s);;
+gap> StzSimplifyPresentation(stz1);
+gap> stz2 := StzPresentation(s);;
+gap> while StzSimplifyOnce(stz2) do od;
+gap> GeneratorsOfStzPresentation(stz1) = GeneratorsOfStzPresentation(stz2);
+true
+gap> RelationsOfStzPresentation(stz1) = RelationsOfStzPresentation(stz2);
+true
+gap> TietzeForwardMap(stz1) = TietzeForwardMap(stz2);
+true
+gap> TietzeBackwardMap(stz1) = TietzeBackwardMap(stz2);
+true
+gap> f := FreeSemigroup("x", "y");;
+gap> r := ParseRelations([f.1, f.2],
+>         "xyxyyxyx=yxyxxyxy, xyxyy=yy, yxyxxyxyyx=x, xxx=yxyx");;
+gap> s := f / r;;
+gap> stz1 := StzPresentation(s);;
+gap> StzSimplifyPresentation(stz1);
+gap> stz2 := StzPresentation(s);;
+gap> while StzSimplifyOnce(stz2) do od;
+gap> GeneratorsOfStzPresentation(stz1) = GeneratorsOfStzPresentation(stz2);
+true
+gap> RelationsOfStzPresentation(stz1) = RelationsOfStzPresentation(stz2);
+true
+gap> TietzeForwardMap(stz1) = TietzeForwardMap(stz2);
+true
+gap> TietzeBackwardMap(stz1) = TietzeBackwardMap(stz2);
+true
+gap> SetInfoLevel(InfoFpSemigroup, prevFpSemigroupInfoLevel);;
+
 # Test SEMIGROUPS.StzFrequentSubwordApply
 gap> prevFpSemigroupInfoLevel := InfoLevel(InfoFpSemigroup);;
 gap> SetInfoLevel(InfoFpSemigroup, 1);;
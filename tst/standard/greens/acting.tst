@@ -1192,19 +1192,28 @@ gap> GeneratorsOfGroup(Range(x));
 gap> IsomorphismPermGroup(HClass(S, S.1));
 Error, the argument (a Green's H-class) is not a group
 
-# PartialOrderOfDClasses, 1/2
+# PartialOrderOfDClasses, 1/3
 gap> S := AsSemigroup(IsTransformationSemigroup, FullBooleanMatMonoid(3));;
 gap> S := Semigroup(S, rec(acting := true));;
 gap> PartialOrderOfDClasses(S);
 <immutable digraph with 11 vertices, 25 edges>
 
-# PartialOrderOfDClasses, 2/2
+# PartialOrderOfDClasses, 2/3
 gap> S := Semigroup([Transformation([2, 3, 6, 5, 4, 8, 10, 4, 1, 4]),
 >  Transformation([10, 2, 5, 4, 10, 3, 1, 6, 9, 6])],
 > rec(acting := true));;
 gap> PartialOrderOfDClasses(S);
 <immutable digraph with 201 vertices, 918 edges>
 
+# PartialOrderOfDClasses, 3/3
+gap> S := AsSemigroup(IsTransformationSemigroup, FullBooleanMatMonoid(3));;
+gap> S := Semigroup(S, rec(acting := true, nr_threads := 2));;
+gap> D := GreensDClasses(S);;
+gap> DigraphReflexiveTransitiveClosure(PartialOrderOfDClasses(S))
+> = Digraph(List(D, x -> Filtered([1 .. Length(D)],
+>                                 i -> IsGreensLessThanOrEqual(D[i], x))));
+true
+
 # Idempotents, 1/?
 gap> S := AsSemigroup(IsTransformationSemigroup, FullPBRMonoid(1));;
 gap> S := Semigroup(S, rec(acting := true));;
@@ -1338,6 +1347,22 @@ gap> Idempotents(S);;
 gap> NrIdempotents(S);
 24
 
+# NrIdempotents, for transformation semigroups, using several threads
+gap> S := Semigroup(FullTransformationMonoid(6), rec(nr_threads := 2));;
+gap> NrIdempotents(S);
+1057
+gap> S := Monoid([Transformation([3, 2, 3, 3, 5, 5]),
+>                 Transformation([5, 4, 4, 5, 1, 4]),
+>                 Transformation([1, 1, 5, 3, 3]),
+>                 Transformation([4, 5, 6, 4, 1, 4])],
+>                rec(nr_threads := 2));;
+gap> NrIdempotents(S) = Number(S, IsIdempotent);
+true
+gap> ForAll(DClasses(S), D -> NrIdempotents(D) = Number(D, IsIdempotent));
+true
+gap> ForAll(LClasses(S), L -> NrIdempotents(L) = Number(L, IsIdempotent));
+true
+
 # NrIdempotents, for a D-class, 1/2
 gap> S := Semigroup([Transformation([2, 3, 4, 5, 1, 5, 6, 7, 8])]);;
 gap> D := DClass(S, S.1);
@@ -8,7 +8,7 @@
 #############################################################################
 ##
 
-#@local C, D, F, I, R, S, T, cong, hom, t, u
+#@local C, CC, D, F, I, P, R, S, T, cong, hom, t, tc, u, words
 gap> START_TEST("Semigroups package: standard/libsemigroups/cong.tst");
 gap> LoadPackage("semigroups", false);;
 
@@ -89,6 +89,17 @@ gap> C := SemigroupCongruence(S, [[S.1, S.3]]);
 <2-sided semigroup congruence over <regular monoid 
  of size 16, 2x2 boolean matrices with 3 generators> with 1 generating pairs>
 gap> LibsemigroupsCongruence(C);;  # Can't test output because it contains the memory address
+gap> libsemigroups.Congruence.number_of_pairs(LibsemigroupsCongruence(C));
+1
+gap> D := SemigroupCongruence(S, [[S.1, S.3], [S.2, S.2 * S.3]]);;
+gap> libsemigroups.Congruence.number_of_pairs(LibsemigroupsCongruence(D));
+2
+gap> NrEquivalenceClasses(D) = NrEquivalenceClasses(JoinSemigroupCongruences(C,
+> SemigroupCongruence(S, [[S.2, S.2 * S.3]])));
+true
+gap> libsemigroups.Congruence.add_pairs_by_position(LibsemigroupsCongruence(D),
+> [[1, 17]]);
+Error, the 2nd argument must consist of pairs of integers in the range [1, 16]
 
 # LibsemigroupsCongruence for a congruence on a fp semigroup
 gap> S := FreeSemigroup(2);
@@ -223,6 +234,37 @@ gap> EquivalenceRelationPartition(C);
           [0, 0, 1, 0, 0, 0, 0], [0, 0, 0, 0, 0, 1, 0], [0, 0, 0, 0, 0, 1, 0]]
           ) ] ]
 
+# EquivalenceRelationPartition, EquivalenceRelationLookup, and
+# EquivalenceRelationCanonicalLookup using the positions of elements
+gap> S := FullTransformationMonoid(3);;
+gap> C := SemigroupCongruence(S, [[Transformation([1, 1, 1]),
+>                                  Transformation([1, 2, 1])]]);;
+gap> u := EquivalenceRelationLookup(C);;
+gap> t := EquivalenceRelationCanonicalLookup(C);;
+gap> ForAll([1 .. Size(S)], i -> ForAll([1 .. Size(S)],
+> j -> (u[i] = u[j]) = (t[i] = t[j])
+>      and (t[i] = t[j]) = CongruenceTestMembershipNC(C,
+>                                                   AsListCanonical(S)[i],
+>                                                   AsListCanonical(S)[j])));
+true
+gap> t = FlatKernelOfTransformation(Transformation(u), Length(u));
+true
+gap> Maximum(t) = NrEquivalenceClasses(C);
+true
+gap> Set(EquivalenceRelationPartition(C), Set)
+> = Set(Filtered(EquivalenceRelationPartitionWithSingletons(C),
+>                x -> Size(x) > 1), Set);
+true
+gap> F := FreeSemigroup(2);;
+gap> S := F / [[F.1 ^ 2, F.1], [F.2 ^ 2, F.2], [F.1 * F.2, F.2 * F.1]];;
+gap> C := SemigroupCongruence(S, [[S.1, S.2]]);;
+gap> List(EquivalenceRelationPartition(C), Size);
+[ 3 ]
+gap> Set(EquivalenceRelationLookup(C));
+[ 1 ]
+gap> EquivalenceRelationCanonicalLookup(C);
+[ 1, 1, 1 ]
+
 # \< for congruence classes
 gap> S := FreeBand(2);
 <free band on the generators [ x1, x2 ]>
@@ -305,6 +347,99 @@ gap> ImagesElm(C, S.1);
 gap> ImagesElm(C, S.3);
 [ s3 ]
 
+# Strategy portfolio for congruences on fp semigroups and monoids
+gap> SEMIGROUPS.DefaultOptionsRec.cong_portfolio_budget := 1000;;
+gap> F := FreeMonoid(2);;
+gap> S := F / [[F.1 ^ 2, One(F)], [F.2 ^ 2, One(F)], [F.1 * F.2, F.2 * F.1]];;
+gap> C := SemigroupCongruence(S, [[S.1, S.2]]);;
+gap> NrEquivalenceClasses(C);
+2
+gap> CongruenceTestMembershipNC(C, S.1, S.2);
+true
+gap> CongruenceTestMembershipNC(C, S.1, One(S));
+false
+gap> C!.LibsemigroupsCongruenceStrategy.strategy
+> in ["todd_coxeter(hlt, partial)", "knuth_bendix",
+>     "todd_coxeter(felsch, partial)", "todd_coxeter(hlt, full)",
+>     "todd_coxeter(Rc, partial)"];
+true
+gap> IsInt(C!.LibsemigroupsCongruenceStrategy.time);
+true
+gap> Length(EquivalenceRelationPartition(C));
+2
+gap> SEMIGROUPS.DefaultOptionsRec.cong_portfolio_budget := 0;;
+gap> C := SemigroupCongruence(S, [[S.1, S.2]]);;
+gap> NrEquivalenceClasses(C);
+2
+gap> IsBound(C!.LibsemigroupsCongruenceStrategy);
+false
+gap> P := libsemigroups.CongruencePortfolio.make("left");;
+gap> libsemigroups.CongruencePortfolio.add_knuth_bendix(P);
+Error, KnuthBendix can only be used for 2-sided congruences
+gap> tc := libsemigroups.ToddCoxeter.make("left");;
+gap> libsemigroups.CongruencePortfolio.add_todd_coxeter(P, tc, "x", "full");
+Error, expected one of "hlt", "felsch", "CR", "R/C", "Cr", or "Rc", found "x"
+gap> libsemigroups.CongruencePortfolio.add_todd_coxeter(P, tc, "hlt", "bad");
+Error, expected "full" or "partial", found "bad"
+gap> libsemigroups.CongruencePortfolio.number_of_runners(P);
+0
+gap> libsemigroups.CongruencePortfolio.run_for(P, 0, 4);
+Error, the number of generators is not defined
+gap> libsemigroups.CongruencePortfolio.winner(P);
+Error, no runner in the portfolio has finished
+gap> libsemigroups.CongruencePortfolio.add_pair(P, [0], [1]);
+Error, the number of generators is not defined
+gap> P := libsemigroups.CongruencePortfolio.make("twosided");;
+gap> libsemigroups.CongruencePortfolio.set_number_of_generators(P, 2);
+gap> libsemigroups.CongruencePortfolio.add_pair(P, [0, 0], [0]);
+gap> libsemigroups.CongruencePortfolio.add_knuth_bendix(P);
+gap> libsemigroups.CongruencePortfolio.run_for(P, 1000, 2);
+true
+gap> libsemigroups.CongruencePortfolio.winner(P);
+"knuth_bendix"
+gap> libsemigroups.CongruencePortfolio.add_pair(P, [1, 1], [1]);
+Error, cannot modify the portfolio after it has been run
+
+# CongruenceWordsToClassIndices
+gap> S := Semigroup(Transformation([2, 1, 3]), Transformation([2, 3, 1]),
+>                   Transformation([1, 1, 2]));;
+gap> C := SemigroupCongruence(S, [[Transformation([1, 1, 1]),
+>                                  Transformation([2, 2, 1])]]);;
+gap> words := List(S, x -> MinimalFactorization(S, x));;
+gap> CongruenceWordsToClassIndices(C, words)
+> = List(words, w -> CongruenceWordToClassIndex(C, w));
+true
+gap> CongruenceWordsToClassIndices(C, AsList(S))
+> = List(AsList(S), x -> CongruenceWordToClassIndex(C, x));
+true
+gap> CongruenceWordsToClassIndices(C, []);
+[  ]
+gap> CC := LibsemigroupsCongruence(C);;
+gap> libsemigroups.Congruence.word_to_class_index_batch(CC, [[1, 4]], 2);
+Error, the 2nd argument must consist of lists of integers in the range [1, 3]
+gap> libsemigroups.Congruence.word_to_class_index_batch(CC, [1], 2);
+Error, the 2nd argument must consist of lists
+gap> libsemigroups.Congruence.position_to_class_index_batch(CC, [0], 2);
+Error, the 2nd argument must consist of integers in the range [1, 27]
+gap> libsemigroups.Congruence.position_to_class_index_batch(CC, [1, 27], 1)
+> = CongruenceWordsToClassIndices(C, EnumeratorCanonical(S){[1, 27]});
+true
+
+# ToddCoxeter.prefill_from_cayley_graph
+gap> tc := libsemigroups.ToddCoxeter.make("twosided");;
+gap> libsemigroups.ToddCoxeter.set_number_of_generators(tc, 1);
+gap> libsemigroups.ToddCoxeter.prefill_from_cayley_graph(tc, [[2], [3], [1]]);
+gap> CC := libsemigroups.Congruence.make_from_table("twosided", "none");;
+gap> libsemigroups.Congruence.set_number_of_generators(CC, 1);
+gap> libsemigroups.Congruence.add_runner(CC, tc);
+gap> libsemigroups.Congruence.number_of_classes(CC);
+3
+gap> tc := libsemigroups.ToddCoxeter.make("twosided");;
+gap> libsemigroups.ToddCoxeter.prefill_from_cayley_graph(tc, [[1, 2], [2]]);
+Error, expected a plain list of length 2 in position 2
+gap> libsemigroups.ToddCoxeter.prefill_from_cayley_graph(tc, [[1, 3], [1, 2]]);
+Error, expected integers in the range [1, 2] in row 1
+
 #
 gap> SEMIGROUPS.StopTest();
 gap> STOP_TEST("Semigroups package: standard/libsemigroups/cong.tst");
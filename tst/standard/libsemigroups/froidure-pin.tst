@@ -15,6 +15,7 @@
 #@local number_of_generators, number_of_idempotents, opts, position
 #@local position_to_sorted_position, prefix, rels, right_cayley_graph, rules
 #@local size, sorted_at, sorted_position, suffix, x
+#@local T, U, file, filename
 gap> START_TEST("Semigroups package: standard/libsemigroups/froidure-pin.tst");
 gap> LoadPackage("semigroups", false);;
 
@@ -773,6 +774,56 @@ gap> MultiplicationTable(S);
 [ [ 1, 1, 1, 1, 5, 6 ], [ 1, 1, 1, 2, 5, 6 ], [ 3, 3, 3, 3, 5, 6 ], 
   [ 1, 2, 3, 4, 5, 6 ], [ 5, 5, 5, 5, 5, 5 ], [ 6, 6, 6, 6, 6, 6 ] ]
 
+# Reading and writing the state of a FroidurePin
+gap> S := Semigroup(Transformation([2, 3, 4, 1]), Transformation([2, 1]),
+>                   Transformation([1, 2, 3, 1]));;
+gap> filename := Filename(DirectoryTemporary(), "froidure-pin.bin");;
+gap> SEMIGROUPS.WriteFroidurePin(S, filename);
+gap> T := Semigroup(GeneratorsOfSemigroup(S));;
+gap> file := SEMIGROUPS.ReadFroidurePin(T, filename);;
+gap> HasSize(T) and Size(T) = 256;
+true
+gap> RightCayleyGraphSemigroup(T) = RightCayleyGraphSemigroup(S);
+true
+gap> LeftCayleyGraphSemigroup(T) = LeftCayleyGraphSemigroup(S);
+true
+gap> RulesOfSemigroup(T) = RulesOfSemigroup(S);
+true
+gap> libsemigroups.FroidurePinFile.idempotents(file)
+> = Filtered([1 .. Size(S)], i -> IsIdempotent(AsListCanonical(S)[i]));
+true
+gap> ForAll([1 .. Size(S)],
+>           i -> libsemigroups.FroidurePinFile.factorisation(file, i - 1) + 1
+>                = MinimalFactorization(S, i));
+true
+gap> libsemigroups.FroidurePinFile.prefix(file, 256);
+Error, the argument must be less than 256, found 256
+gap> U := Semigroup(Transformation([2, 3, 1]), Transformation([2, 1]),
+>                   Transformation([1, 2, 1]));;
+gap> SEMIGROUPS.ReadFroidurePin(U, filename);
+Error, the 2nd argument (a file name) contains a semigroup with different gene\
+rators than the 1st argument (a semigroup)
+gap> HasSize(U);
+false
+gap> Size(U);
+27
+gap> SEMIGROUPS.ReadFroidurePin(U, filename);
+Error, the 2nd argument (a file name) contains a semigroup of size 256 but the\
+ 1st argument (a semigroup) has size 27
+gap> SEMIGROUPS.ReadFroidurePin(Semigroup(Transformation([2, 3, 4, 1]),
+>                                         Transformation([2, 1]),
+>                                         Transformation([2, 1])),
+>                               filename);
+Error, the 2nd argument (a file name) contains a semigroup with different gene\
+rators than the 1st argument (a semigroup)
+gap> SEMIGROUPS.ReadFroidurePin(Semigroup(Transformation([2, 1])), filename);
+Error, the 2nd argument (a file name) contains a semigroup with 3 generators, \
+but the 1st argument (a semigroup) has 1 generators
+gap> filename := Filename(DirectoryTemporary(), "not-froidure-pin.bin");;
+gap> FileString(filename, ListWithIdenticalEntries(100, 'a'));;
+gap> SEMIGROUPS.ReadFroidurePin(S, filename);
+Error, the file is not a FroidurePin file
+
 # 
 gap> SEMIGROUPS.StopTest();
 gap> STOP_TEST("Semigroups package: standard/libsemigroups/froidure-pin.tst");
@@ -8,7 +8,7 @@
 #############################################################################
 ##
 
-#@local F, R, S, e, it
+#@local F, R, S, T, c, e, it, q, sims1
 gap> START_TEST("Semigroups package: standard/libsemigroups/sims1.tst");
 gap> LoadPackage("semigroups", false);;
 
@@ -374,6 +374,81 @@ gap> IteratorOfLeftCongruences(S, Size(S), [[S.1, fail], [S.1, S.3]]);
 Error, the 3rd argument (a list of length 2) must consist of pairs of elements\
  of the 1st argument (a semigroup)
 
+# Sims1Counter and Sims1Iterator.next_k
+gap> S := PartitionMonoid(2);
+<regular bipartition *-monoid of size 15, degree 2 with 3 generators>
+gap> sims1 := LibsemigroupsSims1(S, 10, [], "right");;
+gap> c := libsemigroups.Sims1Counter.make();;
+gap> libsemigroups.Sims1Counter.init(c, sims1, 10, 20);
+gap> libsemigroups.Sims1Counter.run(c);
+20
+gap> libsemigroups.Sims1Counter.finished(c);
+true
+gap> libsemigroups.Sims1Counter.init(c, sims1, 10, 0);
+gap> libsemigroups.Sims1Counter.finished(c);
+false
+gap> libsemigroups.Sims1Counter.start(c);
+gap> libsemigroups.Sims1Counter.wait(c);
+86
+gap> libsemigroups.Sims1Counter.count(c);
+86
+gap> libsemigroups.Sims1Counter.init(c, sims1, 10, 1000);
+gap> libsemigroups.Sims1Counter.run(c);
+86
+gap> F := FreeMonoidAndAssignGeneratorVars("a", "b");
+<free monoid on the generators [ a, b ]>
+gap> R := [[a ^ 3, a], [b ^ 2, b], [(a * b) ^ 2, a]];
+[ [ a^3, a ], [ b^2, b ], [ (a*b)^2, a ] ]
+gap> S := F / R;
+<fp monoid with 2 generators and 3 relations of length 14>
+gap> sims1 := LibsemigroupsSims1(S, 3, [], "right");;
+gap> it := libsemigroups.Sims1.cbegin(sims1, 3);;
+gap> libsemigroups.Sims1Iterator.next_k(it, 2);
+[ [ [ 1, 1 ] ], [ [ 2, 1 ], [ 2, 2 ] ] ]
+gap> libsemigroups.Sims1Iterator.next_k(it, 10);
+[ [ [ 2, 2 ], [ 2, 2 ] ], [ [ 2, 3 ], [ 2, 2 ], [ 2, 3 ] ], 
+  [ [ 2, 3 ], [ 2, 2 ], [ 3, 3 ] ] ]
+gap> libsemigroups.Sims1Iterator.next_k(it, 10);
+[  ]
+gap> q := libsemigroups.Sims1Queue.make();;
+gap> libsemigroups.Sims1Queue.init(q, sims1, 3, 2);
+gap> libsemigroups.Sims1Queue.out_degree(q);
+2
+gap> libsemigroups.Sims1Queue.next_k(q, 1);
+[ [ [ 1, 1 ] ] ]
+gap> e := [];;
+gap> repeat
+>   c := libsemigroups.Sims1Queue.next_k(q, 10);
+>   Append(e, c);
+> until IsEmpty(c);
+gap> e = [[[2, 1], [2, 2]], [[2, 2], [2, 2]], [[2, 3], [2, 2], [2, 3]],
+>         [[2, 3], [2, 2], [3, 3]]];
+true
+gap> libsemigroups.Sims1Queue.next_k(q, 10);
+[  ]
+gap> libsemigroups.Sims1Queue.init(q, sims1, 3, 1);
+gap> libsemigroups.Sims1Queue.stop(q);
+gap> S := PartitionMonoid(2);;
+gap> S := Monoid(GeneratorsOfMonoid(S), rec(nr_threads := 1));;
+gap> NumberOfRightCongruences(S, 10);
+86
+gap> it := IteratorOfRightCongruences(S, 10);;
+gap> e := 0;;
+gap> while not IsDoneIterator(it) do NextIterator(it); e := e + 1; od;
+gap> e;
+86
+gap> T := Monoid(GeneratorsOfMonoid(S), rec(nr_threads := 4));;
+gap> it := IteratorOfRightCongruences(T, 10);;
+gap> e := 0;;
+gap> while not IsDoneIterator(it) do NextIterator(it); e := e + 1; od;
+gap> e;
+86
+gap> it := ShallowCopy(IteratorOfLeftCongruences(T, 10));;
+gap> e := 0;;
+gap> while not IsDoneIterator(it) do NextIterator(it); e := e + 1; od;
+gap> e;
+86
+
 #
 gap> SEMIGROUPS.StopTest();
 gap> STOP_TEST("Semigroups package: standard/libsemigroups/sims1.tst");
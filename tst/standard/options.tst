@@ -8,8 +8,9 @@
 #############################################################################
 ##
 
-#@local acting, batch_size, cong_by_ker_trace_threshold, hashlen, nr_threads
-#@local regular, small
+#@local acting, batch_size, cong_by_ker_trace_threshold
+#@local cong_lattice_by_ker_trace_threshold, cong_portfolio_budget, hashlen
+#@local nr_threads, regular, small
 gap> START_TEST("Semigroups package: standard/options.tst");
 gap> LoadPackage("semigroups", false);;
 
@@ -18,36 +19,51 @@ gap> SEMIGROUPS.StartTest();
 gap> SEMIGROUPS.DefaultOptionsRec.acting := true;;
 
 # SEMIGROUPS.ProcessOptionsRec
-gap> SEMIGROUPS.ProcessOptionsRec(SEMIGROUPS.DefaultOptionsRec, rec(hashlen := 103));
-rec( acting := true, batch_size := 8192, cong_by_ker_trace_threshold := 100000
-    , hashlen := 103, nr_threads := 4, regular := false, small := false )
+gap> SEMIGROUPS.ProcessOptionsRec(SEMIGROUPS.DefaultOptionsRec, rec(hashlen := 103))
+> = rec(acting := true, batch_size := 8192,
+>       cong_by_ker_trace_threshold := 100000,
+>       cong_lattice_by_ker_trace_threshold := 1000, cong_portfolio_budget := 0,
+>       hashlen := 103, nr_threads := 4, regular := false, small := false);
+true
 
 # SEMIGROUPS.OptionsRec
-gap> SEMIGROUPS.OptionsRec(TrivialSemigroup());
-rec( acting := true, batch_size := 8192, cong_by_ker_trace_threshold := 100000
-    , hashlen := 12517, nr_threads := 4, regular := false, small := false )
-gap> SEMIGROUPS.OptionsRec(Group(()));
-rec( acting := true, batch_size := 8192, cong_by_ker_trace_threshold := 100000
-    , hashlen := 12517, nr_threads := 4, regular := false, small := false )
+gap> SEMIGROUPS.OptionsRec(TrivialSemigroup())
+> = rec(acting := true, batch_size := 8192,
+>       cong_by_ker_trace_threshold := 100000,
+>       cong_lattice_by_ker_trace_threshold := 1000, cong_portfolio_budget := 0,
+>       hashlen := 12517, nr_threads := 4, regular := false, small := false);
+true
+gap> SEMIGROUPS.OptionsRec(Group(()))
+> = rec(acting := true, batch_size := 8192,
+>       cong_by_ker_trace_threshold := 100000,
+>       cong_lattice_by_ker_trace_threshold := 1000, cong_portfolio_budget := 0,
+>       hashlen := 12517, nr_threads := 4, regular := false, small := false);
+true
 
 # 
 gap> SEMIGROUPS.DefaultOptionsRec.acting := false;;
 
 # SEMIGROUPS.ProcessOptionsRec
-gap> SEMIGROUPS.ProcessOptionsRec(SEMIGROUPS.DefaultOptionsRec, rec(hashlen := 103));
-rec( acting := false, batch_size := 8192, 
-  cong_by_ker_trace_threshold := 100000, hashlen := 103, nr_threads := 4, 
-  regular := false, small := false )
+gap> SEMIGROUPS.ProcessOptionsRec(SEMIGROUPS.DefaultOptionsRec, rec(hashlen := 103))
+> = rec(acting := false, batch_size := 8192,
+>       cong_by_ker_trace_threshold := 100000,
+>       cong_lattice_by_ker_trace_threshold := 1000, cong_portfolio_budget := 0,
+>       hashlen := 103, nr_threads := 4, regular := false, small := false);
+true
 
 # SEMIGROUPS.OptionsRec
-gap> SEMIGROUPS.OptionsRec(TrivialSemigroup());
-rec( acting := false, batch_size := 8192, 
-  cong_by_ker_trace_threshold := 100000, hashlen := 12517, nr_threads := 4, 
-  regular := false, small := false )
-gap> SEMIGROUPS.OptionsRec(Group(()));
-rec( acting := false, batch_size := 8192, 
-  cong_by_ker_trace_threshold := 100000, hashlen := 12517, nr_threads := 4, 
-  regular := false, small := false )
+gap> SEMIGROUPS.OptionsRec(TrivialSemigroup())
+> = rec(acting := false, batch_size := 8192,
+>       cong_by_ker_trace_threshold := 100000,
+>       cong_lattice_by_ker_trace_threshold := 1000, cong_portfolio_budget := 0,
+>       hashlen := 12517, nr_threads := 4, regular := false, small := false);
+true
+gap> SEMIGROUPS.OptionsRec(Group(()))
+> = rec(acting := false, batch_size := 8192,
+>       cong_by_ker_trace_threshold := 100000,
+>       cong_lattice_by_ker_trace_threshold := 1000, cong_portfolio_budget := 0,
+>       hashlen := 12517, nr_threads := 4, regular := false, small := false);
+true
 
 #
 gap> SEMIGROUPS.StopTest();
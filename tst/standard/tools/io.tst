@@ -8,7 +8,7 @@
 #############################################################################
 ##
 
-#@local file, fname, gens, it, name, table, tables, x
+#@local S, file, fname, gens, it, name, props, table, tables, x
 gap> START_TEST("Semigroups package: standard/tools/io.tst");
 gap> LoadPackage("semigroups", false);;
 
@@ -191,6 +191,8 @@ gap> ReadMultiplicationTable(name, 3);
   [ 9, 9, 1, 3, 4, 5, 6, 7, 8, 9 ], [ 1, 10, 3, 4, 5, 6, 7, 8, 9, 2 ] ]
 gap> ReadMultiplicationTable(name, 3, 4);
 Error, there should be 1 or 2 arguments
+gap> ReadMultiplicationTable(name, 49);
+Error, the file only has 48 lines
 gap> ReadMultiplicationTable("non-existant-file");
 Error, could not open the file "non-existant-file"
 gap> file := IO_CompressedFile(name, "r");;
@@ -260,6 +262,8 @@ gap> table := [[1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16],
 > [16, 10, 7, 13, 12, 1, 15, 3, 2, 14, 6, 4, 5, 9, 8, 11]];;
 gap> WriteMultiplicationTable(name, [table]);
 IO_OK
+gap> ReadMultiplicationTable(name) = [table];
+true
 gap> WriteMultiplicationTable(name, [table + 250]);
 Error, the 2nd argument is not a collection of rectangular tables with integer\
  entries from [1, 2, ..., n] (where n equals the number of rows of the table)
@@ -317,6 +321,40 @@ gap> IsDoneIterator(it);
 true
 #@fi
 
+# Test PropertiesOfMultiplicationTableFile
+#@if not ARCH_IS_WINDOWS()
+gap> name := Concatenation(SEMIGROUPS.PackageDir, "/data/tst/tables.gz");;
+gap> props := PropertiesOfMultiplicationTableFile(name);;
+gap> S := List(ReadMultiplicationTable(name), SemigroupByMultiplicationTable);;
+gap> ForAll(RecNames(props), x -> props.(x) = List(S, ValueGlobal(x)));
+true
+gap> S := [FullTransformationMonoid(3),
+>          SymmetricInverseMonoid(2),
+>          RectangularBand(2, 3),
+>          ZeroSemigroup(4),
+>          AsSemigroup(IsTransformationSemigroup, CyclicGroup(IsPermGroup, 5)),
+>          Semigroup(Transformation([2, 3, 3])),
+>          InverseSemigroup(PartialPerm([1], [2])),
+>          Semigroup(Transformation([1, 1]), Transformation([2, 2]))];;
+gap> name := Filename(DirectoryTemporary(), "tables");;
+gap> WriteMultiplicationTable(name, List(S, MultiplicationTable));
+IO_OK
+gap> props := PropertiesOfMultiplicationTableFile(name, 2);;
+gap> S := List(ReadMultiplicationTable(name), SemigroupByMultiplicationTable);;
+gap> ForAll(RecNames(props), x -> props.(x) = List(S, ValueGlobal(x)));
+true
+gap> props.IsInverseSemigroup;
+[ false, true, false, false, true, false, true, false ]
+gap> PropertiesOfMultiplicationTableFile(name, 0);
+Error, the 2nd argument is not a positive integer
+gap> PropertiesOfMultiplicationTableFile(name, 2, 3);
+Error, there should be 1 or 2 arguments
+gap> PropertiesOfMultiplicationTableFile(3);
+Error, the 1st argument is not a string or a file
+gap> PropertiesOfMultiplicationTableFile("non-existant-file");
+Error, could not open the file "non-existant-file"
+#@fi
+
 # Test read from an old format file
 gap> ReadGenerators(Filename(DirectoriesPackageLibrary("semigroups",
 >                                                      "data/tst/")[1], 
@@ -358,6 +396,55 @@ gap> WriteGenerators(fname,
 >                    SEMIGROUPS.WriteGeneratorsLine);
 Error, the 2nd argument is incompatible with the file format
 
+# Test the binary format
+gap> fname := Filename(DirectoryTemporary(), "tmpfile.bin");;
+gap> gens := [FullTransformationMonoid(3),
+>             [PartialPerm([1, 2, 4], [3, 5, 100000]), PartialPerm([])],
+>             [Bipartition([[1, 3, -3, -5, -6], [2, 4, 7], [5, 6, 8, 9, -8, -9],
+>                           [10, -1, -4], [-2, -7], [-10]])],
+>             [],
+>             SymmetricInverseMonoid(2)];;
+gap> WriteGenerators(fname, gens, SEMIGROUPS.WriteGeneratorsBinary);
+IO_OK
+gap> x := ReadGenerators(fname);;
+gap> x[1] = GeneratorsOfSemigroup(FullTransformationMonoid(3));
+true
+gap> x{[2 .. 4]} = gens{[2 .. 4]};
+true
+gap> x[5] = GeneratorsOfSemigroup(SymmetricInverseMonoid(2));
+true
+gap> ReadGenerators(fname, 3) = gens[3];
+true
+gap> ReadGenerators(fname, 6);
+Error, the file only has 5 further entries
+gap> WriteGenerators(fname,
+>                    [[Transformation([2, 1, 3])]],
+>                    "a",
+>                    SEMIGROUPS.WriteGeneratorsBinary);
+IO_OK
+gap> ReadGenerators(fname, 6);
+[ Transformation( [ 2, 1 ] ) ]
+gap> ReadGenerators(fname, 2) = gens[2];
+true
+gap> it := IteratorFromGeneratorsFile(fname);
+<iterator>
+gap> NextIterator(it) = x[1];
+true
+gap> NextIterator(it) = x[2];
+true
+gap> NextIterator(ShallowCopy(it)) = x[1];
+true
+gap> for gens in it do od;
+gap> IsDoneIterator(it);
+true
+gap> WriteGenerators(fname,
+>                    [[Transformation([2, 1]), PartialPerm([1])]],
+>                    SEMIGROUPS.WriteGeneratorsBinary);
+Error, the 2nd argument must consist of lists of transformations, partial perm\
+s, or bipartitions, but not a mixture of these
+gap> WriteGenerators(fname, [], SEMIGROUPS.WriteGeneratorsBinary);
+Error, the 2nd argument is not a non-empty list
+
 #
 gap> SEMIGROUPS.StopTest();
 gap> STOP_TEST("Semigroups package: standard/tools/io.tst");